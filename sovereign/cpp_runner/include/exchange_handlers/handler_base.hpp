@@ -0,0 +1,248 @@
+/**
+ * Exchange Handler Base - CRTP Parser Framework
+ *
+ * PURE DATA. NO MOCK. MATH NEVER LIES.
+ *
+ * Shared scanning machinery for the per-exchange handlers in this
+ * directory. Each handler used to carry its own copy of bracket
+ * matching and strtod-based level scanning; now the message layout is
+ * expressed as compile-time traits on the derived class and the base
+ * supplies the primitives:
+ *
+ *   class MexcHandler : public HandlerBase<MexcHandler> {
+ *       static constexpr std::string_view WS_CHANNEL_TOKEN = "...";
+ *       static constexpr std::string_view WS_SCOPE_KEY = "\"d\"";
+ *       static constexpr LevelFormat WS_LEVELS = LevelFormat::QUOTED_LEVELS;
+ *       ...
+ *   };
+ *
+ * Because the traits are constexpr and dispatch is `if constexpr`, the
+ * compiler specializes and inlines a dedicated parser per exchange -
+ * no virtual calls, no std::function, no per-message substr copies
+ * (everything scans std::string_view in place). Numbers go through
+ * std::from_chars: locale-independent and several times faster than
+ * the strtod + substr + c_str round-trip it replaces.
+ *
+ * Handlers with a layout the traits cannot express (e.g. Gemini's
+ * event-stream WS feed) shadow the base method - CRTP makes that a
+ * plain name hiding, still zero-overhead.
+ */
+
+#pragma once
+
+#include "../order_book_types.hpp"
+#include "../simdjson_parsers.hpp"
+#include <charconv>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace sovereign {
+namespace exchange {
+
+/**
+ * How an exchange lays out its price levels.
+ */
+enum class LevelFormat {
+    NUMERIC_PAIRS,          // [[87000.0, 0.5], ...]           (Deribit)
+    QUOTED_LEVELS,          // [["87000","0.5"],...] or flat ["87000","0.5",...]
+                            // - quotes always come in price/amount pairs, so
+                            // nested and flat shapes scan identically
+    PRICE_AMOUNT_OBJECTS,   // [{"price":"87000","amount":"0.5"},...] (Gemini)
+};
+
+template <typename Derived>
+class HandlerBase {
+public:
+    /**
+     * Parse a WebSocket message into OrderBook. Rejects messages that
+     * do not carry the derived handler's channel token.
+     */
+    static bool parse_ws_message(const std::string& json, OrderBook& book) {
+        if constexpr (!Derived::WS_CHANNEL_TOKEN.empty()) {
+            if (json.find(Derived::WS_CHANNEL_TOKEN) == std::string::npos) {
+                return false;
+            }
+        }
+
+#if HAS_SIMDJSON
+        if (simd_parse::parse_book(json, book)) return true;
+#endif
+
+        return parse_sides(scope_view(json, Derived::WS_SCOPE_KEY),
+                           Derived::WS_LEVELS, book);
+    }
+
+    /**
+     * Parse a REST response into OrderBook.
+     */
+    static bool parse_rest_response(const std::string& json, OrderBook& book) {
+#if HAS_SIMDJSON
+        if (simd_parse::parse_book(json, book)) return true;
+#endif
+
+        return parse_sides(scope_view(json, Derived::REST_SCOPE_KEY),
+                           Derived::REST_LEVELS, book);
+    }
+
+protected:
+    /**
+     * Narrow the message to the object holding bids/asks (e.g. Deribit
+     * wraps them under "result", MEXC under "d"). Empty key means the
+     * levels sit at top level.
+     */
+    static std::string_view scope_view(std::string_view json, std::string_view key) {
+        if (key.empty()) return json;
+        size_t pos = json.find(key);
+        if (pos == std::string_view::npos) return {};
+        return json.substr(pos);
+    }
+
+    /**
+     * Locate both sides and parse them with the given format.
+     */
+    static bool parse_sides(std::string_view scope, LevelFormat format, OrderBook& book) {
+        book.bids.clear();
+        book.asks.clear();
+        parse_side(scope, "\"bids\"", format, book.bids);
+        parse_side(scope, "\"asks\"", format, book.asks);
+        return book.is_valid();
+    }
+
+    static void parse_side(std::string_view scope, std::string_view key,
+                           LevelFormat format, std::vector<PriceLevel>& levels) {
+        size_t key_pos = scope.find(key);
+        if (key_pos == std::string_view::npos) return;
+
+        size_t arr_start = scope.find('[', key_pos);
+        size_t arr_end = find_matching_bracket(scope, arr_start);
+        if (arr_start == std::string_view::npos || arr_end == std::string_view::npos) {
+            return;
+        }
+
+        std::string_view arr = scope.substr(arr_start, arr_end - arr_start + 1);
+        switch (format) {
+            case LevelFormat::NUMERIC_PAIRS:        parse_numeric_pairs(arr, levels); break;
+            case LevelFormat::QUOTED_LEVELS:        parse_quoted_levels(arr, levels); break;
+            case LevelFormat::PRICE_AMOUNT_OBJECTS: parse_object_levels(arr, levels); break;
+        }
+    }
+
+    /**
+     * Index of the ']' closing the '[' at start, npos if unbalanced.
+     * Hops bracket to bracket with memchr-backed find instead of a
+     * byte loop - on a 50-level array that is the difference between
+     * scanning ~1.2KB per side and a handful of vectorized probes.
+     */
+    static size_t find_matching_bracket(std::string_view s, size_t start) {
+        if (start >= s.size() || s[start] != '[') return std::string_view::npos;
+
+        int depth = 1;
+        size_t pos = start + 1;
+        while (true) {
+            size_t close = s.find(']', pos);
+            if (close == std::string_view::npos) return std::string_view::npos;
+            size_t open = s.find('[', pos);
+            while (open != std::string_view::npos && open < close) {
+                depth++;
+                open = s.find('[', open + 1);
+            }
+            depth--;
+            if (depth == 0) return close;
+            pos = close + 1;
+        }
+    }
+
+    /**
+     * from_chars-based double parse: no locale, no copy, no strtod.
+     * Returns 0.0 (which level validation rejects) on garbage.
+     */
+    static double parse_double(std::string_view s) {
+        // Skip leading whitespace - from_chars accepts none
+        size_t begin = s.find_first_not_of(" \t");
+        if (begin == std::string_view::npos) return 0.0;
+
+        double value = 0.0;
+        std::from_chars(s.data() + begin, s.data() + s.size(), value);
+        return value;
+    }
+
+    // Parse [[price, amount], ...] format (numeric values)
+    static void parse_numeric_pairs(std::string_view arr, std::vector<PriceLevel>& levels) {
+        size_t pos = 1;  // Skip the outer '['
+        while (pos < arr.size() && levels.size() < MAX_BOOK_LEVELS) {
+            size_t inner_start = arr.find('[', pos);
+            if (inner_start == std::string_view::npos) break;
+            size_t inner_end = arr.find(']', inner_start);
+            if (inner_end == std::string_view::npos) break;
+
+            std::string_view inner = arr.substr(inner_start + 1,
+                                                inner_end - inner_start - 1);
+            size_t comma = inner.find(',');
+            if (comma != std::string_view::npos) {
+                double price = parse_double(inner.substr(0, comma));
+                double amount = parse_double(inner.substr(comma + 1));
+                if (price > 0.0 && amount > 0.0) {
+                    levels.push_back({price, amount});
+                }
+            }
+
+            pos = inner_end + 1;
+        }
+    }
+
+    // Parse quoted price/amount runs: covers both [["p","a"],...] and
+    // the flat ["p","a","p","a",...] shape (quotes pair up either way)
+    static void parse_quoted_levels(std::string_view arr, std::vector<PriceLevel>& levels) {
+        size_t pos = 1;  // Skip the outer '['
+        while (pos < arr.size() && levels.size() < MAX_BOOK_LEVELS) {
+            std::string_view price_str = next_quoted(arr, pos);
+            std::string_view amount_str = next_quoted(arr, pos);
+            if (price_str.empty() && amount_str.empty()) break;
+
+            double price = parse_double(price_str);
+            double amount = parse_double(amount_str);
+            if (price > 0.0 && amount > 0.0) {
+                levels.push_back({price, amount});
+            }
+        }
+    }
+
+    // Parse [{"price":"..","amount":".."},...] format (Gemini style)
+    static void parse_object_levels(std::string_view arr, std::vector<PriceLevel>& levels) {
+        size_t pos = 0;
+        while (pos < arr.size() && levels.size() < MAX_BOOK_LEVELS) {
+            size_t price_key = arr.find("\"price\"", pos);
+            if (price_key == std::string_view::npos) break;
+            pos = price_key + 7;
+            std::string_view price_str = next_quoted(arr, pos);
+
+            size_t amount_key = arr.find("\"amount\"", pos);
+            if (amount_key == std::string_view::npos) break;
+            pos = amount_key + 8;
+            std::string_view amount_str = next_quoted(arr, pos);
+
+            double price = parse_double(price_str);
+            double amount = parse_double(amount_str);
+            if (price > 0.0 && amount > 0.0) {
+                levels.push_back({price, amount});
+            }
+        }
+    }
+
+    /**
+     * Content of the next "..." at or after pos; advances pos past the
+     * closing quote. Empty view (and unmoved pos) when none remains.
+     */
+    static std::string_view next_quoted(std::string_view s, size_t& pos) {
+        size_t q1 = s.find('\"', pos);
+        if (q1 == std::string_view::npos) return {};
+        size_t q2 = s.find('\"', q1 + 1);
+        if (q2 == std::string_view::npos) return {};
+        pos = q2 + 1;
+        return s.substr(q1 + 1, q2 - q1 - 1);
+    }
+};
+
+} // namespace exchange
+} // namespace sovereign
@@ -9,11 +9,13 @@
 
 #include "mmap_addresses.hpp"
 #include "utxo_cache.hpp"
+#include "tx_decoder.hpp"
 #include <string>
 #include <vector>
 #include <optional>
 #include <cstdint>
 #include <memory>
+#include <chrono>
 
 // Signal types for deterministic trading
 enum class SignalType : uint8_t {
@@ -24,9 +26,16 @@ enum class SignalType : uint8_t {
     MIXED             // Neither threshold met = skip
 };
 
-// Cache-aligned for optimal performance
+// More distinct exchanges than this in one tx means a mixer, not a flow
+constexpr size_t MAX_FLOW_EXCHANGES = 8;
+
+// Cache-aligned, fixed-size inline storage only. Built per mempool
+// transaction, and 99.9% of those carry no signal - so constructing
+// and discarding one must not touch the heap. Exchange name pointers
+// reference the UTXO cache intern table / mmap exchange table, both of
+// which outlive any result.
 struct alignas(64) FlowResult {
-    std::string txid;
+    char txid[65];            // hex, NUL-terminated
     double inflow_btc;
     double outflow_btc;
     double net_flow;
@@ -38,11 +47,23 @@ struct alignas(64) FlowResult {
     double external_pct;      // % going external
 
     SignalType signal;
-    std::vector<std::string> source_exchanges;  // Where outflow came from
-    std::vector<std::string> dest_exchanges;    // Where internal goes to
+    uint8_t source_count;
+    uint8_t dest_count;
+    const char* source_exchanges[MAX_FLOW_EXCHANGES];  // Where outflow came from
+    const char* dest_exchanges[MAX_FLOW_EXCHANGES];    // Where internal goes to
     uint64_t latency_ns;
 };
 
+// Decode + address-lookup result, computed without touching mutable
+// detector state. Everything here is pure, so the pipeline can run this
+// stage on several cores while UTXO bookkeeping stays single-threaded.
+struct PreparedTx {
+    DecodedTx tx;
+    std::vector<const char*> output_exchange;  // per output, nullptr if not an exchange
+    std::vector<std::string> output_address;   // per output, empty if unparseable
+    std::chrono::high_resolution_clock::time_point start;
+};
+
 class FlowDetector {
 public:
     // Thresholds for deterministic signals
@@ -55,6 +76,13 @@ public:
     // Process raw transaction bytes from ZMQ with destination classification
     [[nodiscard]] std::optional<FlowResult> process_raw_tx(const uint8_t* data, size_t len);
 
+    // Pipeline stages: prepare is pure and thread-safe (decode, SHA256,
+    // address extraction, mmap lookups); process_prepared applies UTXO
+    // state changes and must run on a single thread.
+    [[nodiscard]] static std::optional<PreparedTx> prepare_raw_tx(
+        const MmapAddressDatabase& addresses, const uint8_t* data, size_t len);
+    [[nodiscard]] std::optional<FlowResult> process_prepared(PreparedTx& prep);
+
     // Print statistics
     void print_stats() const;
 
@@ -20,9 +20,104 @@
 #include "order_book_types.hpp"
 #include <cmath>
 #include <algorithm>
+#include <array>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
 
 namespace sovereign {
 
+// ============================================================================
+// PRECOMPUTED DEPTH LADDER (SoA, SIMD prefix sums)
+// ============================================================================
+
+/**
+ * Structure-of-arrays cumulative depth ladder for one book side.
+ *
+ * The AoS PriceLevel walk rescans the book for every impact query; when
+ * ranking many venues per blockchain signal we query the same book at
+ * several sizes. Building this once per book sequence turns each query
+ * into a binary search over cum_volume plus one interpolation.
+ *
+ * cum_volume[i] = total volume through level i
+ * cum_cost[i]   = total USD cost through level i (for VWAP)
+ *
+ * build() deinterleaves the price/volume pairs and computes both prefix
+ * sums with AVX2 when available (4 doubles per step, in-register shift-
+ * add prefix), falling back to a scalar loop.
+ */
+struct alignas(64) DepthLadder {
+    uint64_t sequence = 0;  // Book sequence this ladder was built from
+    size_t count = 0;
+    std::array<double, MAX_BOOK_LEVELS> price;
+    std::array<double, MAX_BOOK_LEVELS> cum_volume;
+    std::array<double, MAX_BOOK_LEVELS> cum_cost;
+
+    // A ladder is reusable while the book sequence has not moved
+    [[nodiscard]] bool valid_for(uint64_t seq) const noexcept {
+        return count > 0 && sequence == seq;
+    }
+
+#if defined(__AVX2__)
+    // In-register inclusive prefix sum of 4 doubles
+    static inline __m256d prefix_sum4(__m256d x) noexcept {
+        __m256d t = _mm256_permute4x64_pd(x, 0x90);           // [x0 x0 x1 x2]
+        t = _mm256_blend_pd(t, _mm256_setzero_pd(), 0x1);     // [ 0 x0 x1 x2]
+        x = _mm256_add_pd(x, t);
+        __m256d t2 = _mm256_permute2f128_pd(x, x, 0x08);      // [ 0  0 y0 y1]
+        return _mm256_add_pd(x, t2);
+    }
+#endif
+
+    void build(const std::vector<PriceLevel>& levels, uint64_t seq) {
+        sequence = seq;
+        count = std::min(levels.size(), MAX_BOOK_LEVELS);
+
+        double vol_carry = 0.0;
+        double cost_carry = 0.0;
+        size_t i = 0;
+
+#if defined(__AVX2__)
+        static_assert(sizeof(PriceLevel) == 2 * sizeof(double),
+                      "AoS deinterleave assumes packed price/volume pairs");
+        const double* src = reinterpret_cast<const double*>(levels.data());
+        __m256d vol_c = _mm256_setzero_pd();
+        __m256d cost_c = _mm256_setzero_pd();
+
+        for (; i + 4 <= count; i += 4) {
+            __m256d a = _mm256_loadu_pd(src + 2 * i);          // p0 v0 p1 v1
+            __m256d b = _mm256_loadu_pd(src + 2 * i + 4);      // p2 v2 p3 v3
+            __m256d lo = _mm256_permute2f128_pd(a, b, 0x20);   // p0 v0 p2 v2
+            __m256d hi = _mm256_permute2f128_pd(a, b, 0x31);   // p1 v1 p3 v3
+            __m256d p = _mm256_unpacklo_pd(lo, hi);            // p0 p1 p2 p3
+            __m256d v = _mm256_unpackhi_pd(lo, hi);            // v0 v1 v2 v3
+            __m256d c = _mm256_mul_pd(p, v);
+
+            v = _mm256_add_pd(prefix_sum4(v), vol_c);
+            c = _mm256_add_pd(prefix_sum4(c), cost_c);
+
+            _mm256_storeu_pd(&price[i], p);
+            _mm256_storeu_pd(&cum_volume[i], v);
+            _mm256_storeu_pd(&cum_cost[i], c);
+
+            vol_c = _mm256_permute4x64_pd(v, 0xFF);   // broadcast running total
+            cost_c = _mm256_permute4x64_pd(c, 0xFF);
+        }
+        vol_carry = _mm256_cvtsd_f64(vol_c);
+        cost_carry = _mm256_cvtsd_f64(cost_c);
+#endif
+
+        for (; i < count; ++i) {
+            price[i] = levels[i].price;
+            vol_carry += levels[i].volume;
+            cost_carry += levels[i].price * levels[i].volume;
+            cum_volume[i] = vol_carry;
+            cum_cost[i] = cost_carry;
+        }
+    }
+};
+
 class ImpactCalculator {
 public:
     // ========================================================================
@@ -44,10 +139,21 @@ public:
     static PriceImpact calculate_sell_impact(
             double sell_btc,
             const std::vector<PriceLevel>& bids) {
+        return calculate_sell_impact(sell_btc, bids.data(), bids.size());
+    }
+
+    /**
+     * Pointer + count overload for fixed-size level arrays (BookSnapshot)
+     * that never materialize a vector.
+     */
+    static PriceImpact calculate_sell_impact(
+            double sell_btc,
+            const PriceLevel* bids,
+            size_t count) {
 
         PriceImpact impact{};
 
-        if (bids.empty() || sell_btc <= 0.0) {
+        if (count == 0 || sell_btc <= 0.0) {
             impact.volume_remaining = sell_btc;
             return impact;
         }
@@ -56,9 +162,10 @@ public:
         impact.start_price = bids[0].price;
         impact.end_price = impact.start_price;
 
-        for (const auto& level : bids) {
+        for (size_t i = 0; i < count; ++i) {
             if (remaining <= 0.0) break;
 
+            const PriceLevel& level = bids[i];
             double fill = std::min(remaining, level.volume);
             impact.total_cost += level.price * fill;
             impact.volume_filled += fill;
@@ -102,10 +209,20 @@ public:
     static PriceImpact calculate_buy_impact(
             double buy_btc,
             const std::vector<PriceLevel>& asks) {
+        return calculate_buy_impact(buy_btc, asks.data(), asks.size());
+    }
+
+    /**
+     * Pointer + count overload for fixed-size level arrays (BookSnapshot).
+     */
+    static PriceImpact calculate_buy_impact(
+            double buy_btc,
+            const PriceLevel* asks,
+            size_t count) {
 
         PriceImpact impact{};
 
-        if (asks.empty() || buy_btc <= 0.0) {
+        if (count == 0 || buy_btc <= 0.0) {
             impact.volume_remaining = buy_btc;
             return impact;
         }
@@ -114,9 +231,10 @@ public:
         impact.start_price = asks[0].price;
         impact.end_price = impact.start_price;
 
-        for (const auto& level : asks) {
+        for (size_t i = 0; i < count; ++i) {
             if (remaining <= 0.0) break;
 
+            const PriceLevel& level = asks[i];
             double fill = std::min(remaining, level.volume);
             impact.total_cost += level.price * fill;
             impact.volume_filled += fill;
@@ -143,6 +261,71 @@ public:
         return impact;
     }
 
+    // ========================================================================
+    // LADDER-BASED IMPACT (binary search over precomputed prefix sums)
+    // ========================================================================
+
+    /**
+     * Calculate price impact from a prebuilt DepthLadder.
+     *
+     * Equivalent to calculate_sell_impact / calculate_buy_impact over the
+     * same levels (the sign convention works out identically for both
+     * sides), but O(log n) per query instead of a linear walk. Build the
+     * ladder once per book sequence, then query it at as many sizes as
+     * needed - e.g. when ranking venues for one blockchain signal.
+     *
+     * @param amount  BTC to fill
+     * @param ladder  Ladder built from bids (sell) or asks (buy)
+     */
+    static PriceImpact impact_from_ladder(double amount, const DepthLadder& ladder) {
+        PriceImpact impact{};
+
+        if (ladder.count == 0 || amount <= 0.0) {
+            impact.volume_remaining = amount;
+            return impact;
+        }
+
+        impact.start_price = ladder.price[0];
+
+        // First level whose cumulative volume covers the full amount
+        const double* begin = ladder.cum_volume.data();
+        const double* end = begin + ladder.count;
+        size_t idx = std::lower_bound(begin, end, amount) - begin;
+
+        if (idx == ladder.count) {
+            // Book exhausted - partial fill
+            double total = ladder.cum_volume[ladder.count - 1];
+            impact.volume_filled = total;
+            impact.volume_remaining = amount - total;
+            impact.total_cost = ladder.cum_cost[ladder.count - 1];
+            impact.end_price = ladder.price[ladder.count - 1];
+            impact.levels_eaten = static_cast<int>(ladder.count);
+        } else {
+            double prev_vol = idx > 0 ? ladder.cum_volume[idx - 1] : 0.0;
+            double prev_cost = idx > 0 ? ladder.cum_cost[idx - 1] : 0.0;
+            impact.volume_filled = amount;
+            impact.volume_remaining = 0.0;
+            impact.total_cost = prev_cost + ladder.price[idx] * (amount - prev_vol);
+            impact.end_price = ladder.price[idx];
+            impact.levels_eaten = static_cast<int>(idx + 1);
+        }
+
+        if (impact.volume_filled > 0.0) {
+            impact.vwap = impact.total_cost / impact.volume_filled;
+        } else {
+            impact.vwap = impact.start_price;
+        }
+
+        // (start - end) / start is the drop for sells and the negated
+        // rise for buys - same formula both books
+        if (impact.start_price > 0.0) {
+            impact.price_drop_pct = (impact.start_price - impact.end_price)
+                                    / impact.start_price * 100.0;
+        }
+
+        return impact;
+    }
+
     // ========================================================================
     // EXIT PRICE CALCULATION
     // ========================================================================
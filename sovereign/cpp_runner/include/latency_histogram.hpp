@@ -0,0 +1,258 @@
+/**
+ * Latency Histogram - Log-Bucketed Tail Latency Instrumentation
+ *
+ * PURE DATA. NO MOCK. MATH NEVER LIES.
+ *
+ * Averages hide the p99.9 spikes that actually cost money. This is a
+ * lightweight HDR-style histogram: values bucket by power-of-two with
+ * 16 linear sub-buckets per power (~6% value resolution), so recording
+ * is a couple of bit operations plus one relaxed atomic increment -
+ * cheap enough to leave on in production hot paths.
+ *
+ * Named probes cover the pipeline stages (ZMQ receive, tx decode,
+ * address lookup, cache read, impact calc, WebSocket parse). Scrape
+ * with print_stats() for the periodic console dump or write_json()
+ * for machine-readable output next to the order book JSON.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+namespace sovereign {
+
+// ============================================================================
+// PROBE NAMES
+// ============================================================================
+
+enum class LatencyProbe : uint8_t {
+    ZMQ_RECV = 0,    // ZMQ message receive + ring handoff
+    TX_DECODE,       // Raw transaction decode
+    ADDR_LOOKUP,     // Output address resolution against mmap database
+    CACHE_READ,      // Order book cache snapshot read
+    IMPACT_CALC,     // Price impact calculation
+    WS_PARSE,        // WebSocket message parse
+    COUNT
+};
+
+inline const char* probe_name(LatencyProbe probe) {
+    switch (probe) {
+        case LatencyProbe::ZMQ_RECV:    return "zmq_recv";
+        case LatencyProbe::TX_DECODE:   return "tx_decode";
+        case LatencyProbe::ADDR_LOOKUP: return "addr_lookup";
+        case LatencyProbe::CACHE_READ:  return "cache_read";
+        case LatencyProbe::IMPACT_CALC: return "impact_calc";
+        case LatencyProbe::WS_PARSE:    return "ws_parse";
+        default:                        return "unknown";
+    }
+}
+
+// ============================================================================
+// HISTOGRAM
+// ============================================================================
+
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BUCKET_BITS = 4;
+    static constexpr int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    // One major bucket per power of two above the sub-bucket range,
+    // covering the full uint64 nanosecond range
+    static constexpr int NUM_BUCKETS = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    /**
+     * Record one sample. Lock-free: relaxed atomics only, safe from
+     * any thread.
+     */
+    void record(int64_t ns) {
+        if (ns < 0) ns = 0;
+        counts_[bucket_index(static_cast<uint64_t>(ns))]
+            .fetch_add(1, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+        sum_ns_.fetch_add(static_cast<uint64_t>(ns), std::memory_order_relaxed);
+
+        uint64_t prev = max_ns_.load(std::memory_order_relaxed);
+        while (static_cast<uint64_t>(ns) > prev &&
+               !max_ns_.compare_exchange_weak(prev, static_cast<uint64_t>(ns),
+                                              std::memory_order_relaxed)) {
+        }
+    }
+
+    uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+    uint64_t max_ns() const { return max_ns_.load(std::memory_order_relaxed); }
+
+    uint64_t mean_ns() const {
+        uint64_t n = count();
+        return n > 0 ? sum_ns_.load(std::memory_order_relaxed) / n : 0;
+    }
+
+    /**
+     * Approximate percentile (0-100). Returns the upper bound of the
+     * bucket containing the target rank, so error is bounded by the
+     * ~6% bucket width. Scrape-side only - walks all buckets.
+     */
+    uint64_t percentile_ns(double pct) const {
+        uint64_t total = count();
+        if (total == 0) return 0;
+
+        uint64_t target = static_cast<uint64_t>(pct / 100.0 * total + 0.5);
+        if (target < 1) target = 1;
+        if (target > total) target = total;
+
+        uint64_t seen = 0;
+        for (int i = 0; i < NUM_BUCKETS; ++i) {
+            seen += counts_[i].load(std::memory_order_relaxed);
+            if (seen >= target) {
+                return bucket_upper_bound(i);
+            }
+        }
+        return max_ns();
+    }
+
+    void reset() {
+        for (auto& c : counts_) c.store(0, std::memory_order_relaxed);
+        count_.store(0, std::memory_order_relaxed);
+        sum_ns_.store(0, std::memory_order_relaxed);
+        max_ns_.store(0, std::memory_order_relaxed);
+    }
+
+    /**
+     * Merge another histogram's counts into this one (for per-thread
+     * shards combined on scrape).
+     */
+    void merge(const LatencyHistogram& other) {
+        for (int i = 0; i < NUM_BUCKETS; ++i) {
+            uint64_t c = other.counts_[i].load(std::memory_order_relaxed);
+            if (c) counts_[i].fetch_add(c, std::memory_order_relaxed);
+        }
+        count_.fetch_add(other.count(), std::memory_order_relaxed);
+        sum_ns_.fetch_add(other.sum_ns_.load(std::memory_order_relaxed),
+                          std::memory_order_relaxed);
+        uint64_t om = other.max_ns();
+        uint64_t prev = max_ns_.load(std::memory_order_relaxed);
+        while (om > prev && !max_ns_.compare_exchange_weak(prev, om,
+                                                           std::memory_order_relaxed)) {
+        }
+    }
+
+    static int bucket_index(uint64_t v) {
+        if (v < SUB_BUCKETS) return static_cast<int>(v);
+        int msb = 63 - __builtin_clzll(v);
+        return ((msb - SUB_BUCKET_BITS + 1) << SUB_BUCKET_BITS) +
+               static_cast<int>((v >> (msb - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1));
+    }
+
+    static uint64_t bucket_upper_bound(int idx) {
+        int major = idx >> SUB_BUCKET_BITS;
+        if (major == 0) return static_cast<uint64_t>(idx);
+        uint64_t sub = static_cast<uint64_t>(idx & (SUB_BUCKETS - 1));
+        int shift = major - 1;
+        return ((SUB_BUCKETS + sub + 1) << shift) - 1;
+    }
+
+private:
+    std::array<std::atomic<uint64_t>, NUM_BUCKETS> counts_{};
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> sum_ns_{0};
+    std::atomic<uint64_t> max_ns_{0};
+};
+
+// ============================================================================
+// REGISTRY
+// ============================================================================
+
+class LatencyRegistry {
+public:
+    static LatencyRegistry& instance() {
+        static LatencyRegistry registry;
+        return registry;
+    }
+
+    LatencyHistogram& probe(LatencyProbe p) {
+        return probes_[static_cast<size_t>(p)];
+    }
+
+    /**
+     * Console dump - one line per active probe.
+     */
+    void print_stats() const {
+        printf("\n=== LATENCY STATS (ns) ===\n");
+        printf("%-12s %10s %8s %8s %8s %8s %10s\n",
+               "probe", "count", "mean", "p50", "p99", "p99.9", "max");
+        for (size_t i = 0; i < static_cast<size_t>(LatencyProbe::COUNT); ++i) {
+            const auto& h = probes_[i];
+            if (h.count() == 0) continue;
+            printf("%-12s %10lu %8lu %8lu %8lu %8lu %10lu\n",
+                   probe_name(static_cast<LatencyProbe>(i)),
+                   h.count(), h.mean_ns(),
+                   h.percentile_ns(50.0), h.percentile_ns(99.0),
+                   h.percentile_ns(99.9), h.max_ns());
+        }
+        printf("==========================\n\n");
+    }
+
+    /**
+     * Machine-readable dump. Same format family as the order book
+     * JSON: read it with json.load() from Python monitoring.
+     */
+    bool write_json(const char* filepath) const {
+        FILE* out = fopen(filepath, "w");
+        if (!out) return false;
+
+        fprintf(out, "{\n  \"probes\": {\n");
+        bool first = true;
+        for (size_t i = 0; i < static_cast<size_t>(LatencyProbe::COUNT); ++i) {
+            const auto& h = probes_[i];
+            if (h.count() == 0) continue;
+            if (!first) fprintf(out, ",\n");
+            first = false;
+            fprintf(out,
+                    "    \"%s\": {\"count\": %lu, \"mean_ns\": %lu, "
+                    "\"p50_ns\": %lu, \"p90_ns\": %lu, \"p99_ns\": %lu, "
+                    "\"p999_ns\": %lu, \"max_ns\": %lu}",
+                    probe_name(static_cast<LatencyProbe>(i)),
+                    h.count(), h.mean_ns(),
+                    h.percentile_ns(50.0), h.percentile_ns(90.0),
+                    h.percentile_ns(99.0), h.percentile_ns(99.9), h.max_ns());
+        }
+        fprintf(out, "\n  }\n}\n");
+        fclose(out);
+        return true;
+    }
+
+private:
+    LatencyRegistry() = default;
+    std::array<LatencyHistogram, static_cast<size_t>(LatencyProbe::COUNT)> probes_;
+};
+
+// Hot-path recording helper
+inline void record_latency(LatencyProbe probe, int64_t ns) {
+    LatencyRegistry::instance().probe(probe).record(ns);
+}
+
+/**
+ * RAII probe timer - records elapsed nanoseconds on scope exit.
+ */
+class ScopedLatencyTimer {
+public:
+    explicit ScopedLatencyTimer(LatencyProbe probe)
+        : probe_(probe), start_(std::chrono::high_resolution_clock::now()) {}
+
+    ~ScopedLatencyTimer() {
+        auto end = std::chrono::high_resolution_clock::now();
+        record_latency(probe_,
+            std::chrono::duration_cast<std::chrono::nanoseconds>(end - start_).count());
+    }
+
+    ScopedLatencyTimer(const ScopedLatencyTimer&) = delete;
+    ScopedLatencyTimer& operator=(const ScopedLatencyTimer&) = delete;
+
+private:
+    LatencyProbe probe_;
+    std::chrono::high_resolution_clock::time_point start_;
+};
+
+} // namespace sovereign
@@ -0,0 +1,110 @@
+/**
+ * Level Pool - Per-Thread PriceLevel Buffer Recycling
+ *
+ * PURE DATA. NO MOCK. MATH NEVER LIES.
+ *
+ * Every book update used to allocate fresh std::vector<PriceLevel>
+ * buffers in the parser, move them into the cache, and free the
+ * displaced book's buffers - thousands of alloc/free pairs per second
+ * at WebSocket rates, all for vectors of identical capacity.
+ *
+ * The pool closes that loop: OrderBookCache's write paths release the
+ * displaced buffers to the writing thread's freelist, and the parsers
+ * draw from the same freelist via acquire()/acquire_book(). Since each
+ * feed thread parses and publishes on the same thread, steady-state
+ * operation does zero heap traffic for book updates.
+ *
+ * The freelist is thread_local (LevelPool::local()), so no locking,
+ * and bounded at MAX_POOLED buffers so a burst cannot hoard memory.
+ */
+
+#pragma once
+
+#include "order_book_types.hpp"
+#include <vector>
+
+namespace sovereign {
+
+class LevelPool {
+public:
+    // Upper bound on retained buffers per thread (~100KB at
+    // MAX_BOOK_LEVELS capacity each)
+    static constexpr size_t MAX_POOLED = 64;
+
+    LevelPool() = default;
+
+    // Disable copy (the freelist owns its buffers)
+    LevelPool(const LevelPool&) = delete;
+    LevelPool& operator=(const LevelPool&) = delete;
+
+    /**
+     * The calling thread's pool. Parsers and cache write paths on the
+     * same thread share one freelist, which is what makes the
+     * acquire/release cycle allocation-free.
+     */
+    static LevelPool& local() {
+        thread_local LevelPool pool;
+        return pool;
+    }
+
+    /**
+     * Get an empty level buffer, recycled if one is pooled, freshly
+     * reserved to MAX_BOOK_LEVELS otherwise.
+     */
+    std::vector<PriceLevel> acquire() {
+        if (!free_.empty()) {
+            std::vector<PriceLevel> levels = std::move(free_.back());
+            free_.pop_back();
+            ++hits_;
+            return levels;
+        }
+        ++misses_;
+        std::vector<PriceLevel> levels;
+        levels.reserve(MAX_BOOK_LEVELS);
+        return levels;
+    }
+
+    /**
+     * Get an OrderBook whose bid/ask buffers come from the pool
+     * (skips the constructor's reservation entirely).
+     */
+    OrderBook acquire_book() {
+        OrderBook book{OrderBook::NoReserve{}};
+        book.bids = acquire();
+        book.asks = acquire();
+        return book;
+    }
+
+    /**
+     * Return a buffer to the freelist. Cleared, not shrunk - the
+     * capacity is the whole point. Dropped if the pool is full or the
+     * buffer never allocated.
+     */
+    void release(std::vector<PriceLevel>&& levels) {
+        if (levels.capacity() == 0 || free_.size() >= MAX_POOLED) {
+            return;
+        }
+        levels.clear();
+        free_.push_back(std::move(levels));
+    }
+
+    /**
+     * Return both of a book's buffers to the freelist.
+     */
+    void release_book(OrderBook&& book) {
+        release(std::move(book.bids));
+        release(std::move(book.asks));
+    }
+
+    // Counters for monitoring recycling efficiency
+    size_t pooled() const { return free_.size(); }
+    uint64_t hit_count() const { return hits_; }
+    uint64_t miss_count() const { return misses_; }
+
+private:
+    std::vector<std::vector<PriceLevel>> free_;
+    uint64_t hits_ = 0;
+    uint64_t misses_ = 0;
+};
+
+} // namespace sovereign
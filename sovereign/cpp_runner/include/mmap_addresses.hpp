@@ -2,6 +2,8 @@
 
 #include <string>
 #include <string_view>
+#include <vector>
+#include <algorithm>
 #include <cstdint>
 #include <cstring>
 #include <iostream>
@@ -12,14 +14,20 @@
 
 // Binary file format:
 // Header (64 bytes):
-//   [magic:4][version:4][addr_count:8][exchange_count:4][reserved:44]
+//   [magic:4][version:4][addr_count:8][exchange_count:4][table_capacity:8][reserved:36]
 // Exchange table:
 //   [name_len:1][name:63] x exchange_count (64 bytes each)
-// Address entries (sorted by hash):
-//   [hash:8][exchange_id:2] x addr_count (10 bytes each, padded to 16)
+// Address entries:
+//   v1: [hash:8][exchange_id:2] x addr_count, SORTED by hash (binary search)
+//   v2: [hash:8][exchange_id:2] x table_capacity, open-addressing hash table
+//       (Robin Hood, power-of-two capacity, hash==0 marks an empty slot)
+//
+// v2 exists because binary search over 8.6M entries costs ~23 dependent
+// cache misses per lookup; the hash table touches 1-2 cache lines.
 
 constexpr uint32_t MMAP_MAGIC = 0x41444452;  // "ADDR"
 constexpr uint32_t MMAP_VERSION = 1;
+constexpr uint32_t MMAP_VERSION_V2 = 2;
 constexpr size_t HEADER_SIZE = 64;
 constexpr size_t EXCHANGE_ENTRY_SIZE = 64;
 constexpr size_t ADDRESS_ENTRY_SIZE = 16;  // 8 hash + 2 id + 6 padding
@@ -29,7 +37,8 @@ struct FileHeader {
     uint32_t version;
     uint64_t address_count;
     uint32_t exchange_count;
-    uint8_t reserved[44];
+    uint64_t table_capacity;  // v2 only; zero in v1 files
+    uint8_t reserved[36];
 } __attribute__((packed));
 
 struct AddressEntry {
@@ -85,11 +94,13 @@ public:
 
         // Parse header
         header_ = reinterpret_cast<const FileHeader*>(data_);
-        if (header_->magic != MMAP_MAGIC || header_->version != MMAP_VERSION) {
+        if (header_->magic != MMAP_MAGIC ||
+            (header_->version != MMAP_VERSION && header_->version != MMAP_VERSION_V2)) {
             std::cerr << "Invalid binary file format" << std::endl;
             unload();
             return false;
         }
+        version_ = header_->version;
 
         // Point to exchange names
         exchange_names_ = data_ + HEADER_SIZE;
@@ -100,7 +111,22 @@ public:
         entries_ = reinterpret_cast<const AddressEntry*>(data_ + HEADER_SIZE + exchange_table_size);
         entry_count_ = header_->address_count;
 
-        std::cout << "Loaded " << entry_count_ << " addresses via mmap (INSTANT)" << std::endl;
+        if (version_ == MMAP_VERSION_V2) {
+            table_capacity_ = header_->table_capacity;
+            if (table_capacity_ == 0 || (table_capacity_ & (table_capacity_ - 1)) != 0) {
+                std::cerr << "Invalid v2 table capacity" << std::endl;
+                unload();
+                return false;
+            }
+            table_mask_ = table_capacity_ - 1;
+        }
+
+        // Build the negative-lookup prefilter (tens of ms for 8.6M
+        // keys - the mmap itself is still instant)
+        bloom_build();
+
+        std::cout << "Loaded " << entry_count_ << " addresses via mmap (INSTANT, v"
+                  << version_ << ")" << std::endl;
         return true;
     }
 
@@ -129,11 +155,123 @@ public:
 
     [[nodiscard]] size_t count() const noexcept { return entry_count_; }
 
+    // Exchange name for an id returned by the batch lookup
+    [[nodiscard]] const char* exchange_name(uint16_t id) const noexcept {
+        return get_exchange_name(id);
+    }
+
+    // In-flight lookups per batch chunk - enough to cover main-memory
+    // latency, small enough to stay register/L1-resident
+    static constexpr size_t BATCH_WIDTH = 16;
+
+    /**
+     * Batch lookup: resolve `count` precomputed address hashes into
+     * exchange ids (UINT16_MAX = not an exchange address).
+     *
+     * A single lookup's cache misses are serialized - filter block,
+     * then one or more entry lines. Here each stage prefetches the
+     * next level for every in-flight lookup before touching any of
+     * them, so the misses of a whole chunk overlap instead of
+     * queueing. Large consolidation transactions (dozens to hundreds
+     * of outputs) are exactly the shape this helps.
+     */
+    void find_exchange_ids(const uint64_t* hashes, size_t count, uint16_t* out) const noexcept {
+        for (size_t base = 0; base < count; base += BATCH_WIDTH) {
+            size_t n = std::min(BATCH_WIDTH, count - base);
+
+            uint64_t h[BATCH_WIDTH];
+            bool alive[BATCH_WIDTH];
+
+            // Stage 1: kick off all filter-block loads
+            for (size_t i = 0; i < n; ++i) {
+                h[i] = hashes[base + i] ? hashes[base + i] : 1;
+                if (bloom_enabled_) {
+                    __builtin_prefetch(&bloom_[((h[i] >> 32) & bloom_block_mask_) *
+                                               BLOOM_BLOCK_WORDS]);
+                }
+            }
+
+            // Stage 2: filter, and prefetch the first entry line for
+            // the survivors
+            for (size_t i = 0; i < n; ++i) {
+                alive[i] = !bloom_enabled_ || bloom_contains(h[i]);
+                if (!alive[i]) {
+                    out[base + i] = UINT16_MAX;
+                } else if (version_ == MMAP_VERSION_V2) {
+                    __builtin_prefetch(&entries_[h[i] & table_mask_]);
+                }
+            }
+
+            // Stage 3: resolve the survivors
+            if (version_ == MMAP_VERSION_V2) {
+                // Robin Hood probes are 1-2 cache lines at 50% load;
+                // the first line of every lookup is already in flight
+                for (size_t i = 0; i < n; ++i) {
+                    if (alive[i]) {
+                        out[base + i] = probe_v2(h[i]);
+                    }
+                }
+            } else {
+                // Interleaved binary search: advance every in-flight
+                // lookup one level per round, prefetching its next
+                // midpoint before touching the current one
+                size_t left[BATCH_WIDTH];
+                size_t right[BATCH_WIDTH];
+                size_t pending = 0;
+                for (size_t i = 0; i < n; ++i) {
+                    if (!alive[i]) continue;
+                    left[i] = 0;
+                    right[i] = entry_count_;
+                    __builtin_prefetch(&entries_[entry_count_ / 2]);
+                    pending++;
+                }
+                while (pending > 0) {
+                    for (size_t i = 0; i < n; ++i) {
+                        if (!alive[i]) continue;
+                        if (left[i] >= right[i]) {
+                            out[base + i] = UINT16_MAX;
+                            alive[i] = false;
+                            pending--;
+                            continue;
+                        }
+                        size_t mid = left[i] + (right[i] - left[i]) / 2;
+                        uint64_t mid_hash = entries_[mid].hash;
+                        if (mid_hash == h[i]) {
+                            out[base + i] = entries_[mid].exchange_id;
+                            alive[i] = false;
+                            pending--;
+                            continue;
+                        }
+                        if (mid_hash < h[i]) {
+                            left[i] = mid + 1;
+                        } else {
+                            right[i] = mid;
+                        }
+                        if (left[i] < right[i]) {
+                            __builtin_prefetch(&entries_[left[i] + (right[i] - left[i]) / 2]);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
 private:
     [[nodiscard]] uint16_t find_exchange_id(std::string_view address) const noexcept {
         uint64_t h = hash_address(address);
+        if (h == 0) h = 1;  // 0 is the empty-slot marker in v2
 
-        // Binary search on sorted entries
+        // The overwhelming majority of tx outputs are NOT exchange
+        // addresses - reject them on one cache line before probing
+        if (bloom_enabled_ && !bloom_contains(h)) {
+            return UINT16_MAX;
+        }
+
+        if (version_ == MMAP_VERSION_V2) {
+            return probe_v2(h);
+        }
+
+        // v1: binary search on sorted entries
         size_t left = 0;
         size_t right = entry_count_;
 
@@ -153,6 +291,84 @@ private:
         return UINT16_MAX;  // Not found
     }
 
+    // Robin Hood table: probe until hit or a slot that cannot contain
+    // our key (empty, or its displacement is shorter).
+    [[nodiscard]] uint16_t probe_v2(uint64_t h) const noexcept {
+        size_t idx = h & table_mask_;
+        for (size_t dist = 0; dist < table_capacity_; ++dist) {
+            const AddressEntry& slot = entries_[idx];
+            if (slot.hash == h) return slot.exchange_id;
+            if (slot.hash == 0) return UINT16_MAX;
+            size_t slot_dist = (idx - (slot.hash & table_mask_)) & table_mask_;
+            if (slot_dist < dist) return UINT16_MAX;
+            idx = (idx + 1) & table_mask_;
+        }
+        return UINT16_MAX;
+    }
+
+    // ------------------------------------------------------------------
+    // Blocked Bloom prefilter
+    // ------------------------------------------------------------------
+    // One 64-byte block (a single cache line) per key group, ~10 bits
+    // per key, 6 probe bits per key: ~1% false positives. A negative
+    // answer is exact, so only ~1% of non-exchange outputs ever pay
+    // for the table probe / binary search behind it.
+
+    static constexpr uint64_t BLOOM_BITS_PER_KEY = 10;
+    static constexpr int BLOOM_PROBES = 6;
+    static constexpr size_t BLOOM_BLOCK_WORDS = 8;   // 8 x 64 = 512 bits
+    static constexpr uint32_t BLOOM_BLOCK_BITS = 512;
+
+    // splitmix64 finalizer - decorrelates the probe bits from the
+    // block-index bits (and from the table's low-bit slot index)
+    static uint64_t bloom_mix(uint64_t h) noexcept {
+        h ^= h >> 30; h *= 0xbf58476d1ce4e5b9ULL;
+        h ^= h >> 27; h *= 0x94d049bb133111ebULL;
+        h ^= h >> 31;
+        return h;
+    }
+
+    void bloom_build() {
+        bloom_enabled_ = false;
+        if (entry_count_ == 0) return;
+
+        size_t blocks = 1;
+        while (blocks * BLOOM_BLOCK_BITS < entry_count_ * BLOOM_BITS_PER_KEY) {
+            blocks <<= 1;
+        }
+        bloom_.assign(blocks * BLOOM_BLOCK_WORDS, 0);
+        bloom_block_mask_ = blocks - 1;
+
+        // v2 stores entries sparsely in the open-addressing table;
+        // v1 stores them densely sorted
+        size_t slots = (version_ == MMAP_VERSION_V2) ? table_capacity_ : entry_count_;
+        for (size_t i = 0; i < slots; ++i) {
+            uint64_t h = entries_[i].hash;
+            if (h == 0) continue;
+            uint64_t m = bloom_mix(h);
+            uint64_t* block = &bloom_[((h >> 32) & bloom_block_mask_) * BLOOM_BLOCK_WORDS];
+            for (int p = 0; p < BLOOM_PROBES; ++p) {
+                uint32_t bit = static_cast<uint32_t>(m) & (BLOOM_BLOCK_BITS - 1);
+                m >>= 9;
+                block[bit >> 6] |= 1ULL << (bit & 63);
+            }
+        }
+        bloom_enabled_ = true;
+    }
+
+    [[nodiscard]] bool bloom_contains(uint64_t h) const noexcept {
+        uint64_t m = bloom_mix(h);
+        const uint64_t* block = &bloom_[((h >> 32) & bloom_block_mask_) * BLOOM_BLOCK_WORDS];
+        for (int p = 0; p < BLOOM_PROBES; ++p) {
+            uint32_t bit = static_cast<uint32_t>(m) & (BLOOM_BLOCK_BITS - 1);
+            m >>= 9;
+            if (!(block[bit >> 6] & (1ULL << (bit & 63)))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
     [[nodiscard]] const char* get_exchange_name(uint16_t id) const noexcept {
         if (id >= exchange_count_) return nullptr;
         const uint8_t* entry = exchange_names_ + (id * EXCHANGE_ENTRY_SIZE);
@@ -169,4 +385,11 @@ private:
     const AddressEntry* entries_ = nullptr;
     size_t entry_count_ = 0;
     uint32_t exchange_count_ = 0;
+    uint32_t version_ = MMAP_VERSION;
+    uint64_t table_capacity_ = 0;
+    uint64_t table_mask_ = 0;
+
+    std::vector<uint64_t> bloom_;
+    uint64_t bloom_block_mask_ = 0;
+    bool bloom_enabled_ = false;
 };
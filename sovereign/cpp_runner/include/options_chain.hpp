@@ -0,0 +1,438 @@
+/**
+ * Options Chain Engine - Batch Black-Scholes Greeks
+ *
+ * PURE DATA. NO MOCK. MATH NEVER LIES.
+ *
+ * Deribit, OKX and Bybit each expose hundreds of BTC strikes, but
+ * InstrumentCache::update_greeks() stores one strike at a time through
+ * the per-exchange mutex. This engine keeps a whole chain as SoA
+ * arrays (strikes, IVs, expiries in separate contiguous vectors) and
+ * recomputes every Greek in one vectorized pass when the underlying
+ * moves - the signal path then reads chain-level aggregates (dealer
+ * gamma exposure, max pain) without touching the cache at all.
+ *
+ * The AVX2 kernel processes 4 strikes per iteration with polynomial
+ * exp/log and the Abramowitz-Stegun 26.2.17 normal CDF (|error| <
+ * 7.5e-8, far inside any IV feed's noise). The scalar fallback uses
+ * the same CDF polynomial so both paths produce identical Greeks.
+ *
+ * Threading: single-writer by design. One chain belongs to the thread
+ * that polls its exchange; aggregates are snapshots for that thread.
+ * The publish_atm() bridge pushes the at-the-money strike into the
+ * InstrumentCache so existing single-slot consumers keep working.
+ */
+
+#pragma once
+
+#include "order_book_types.hpp"
+#include "order_book_cache.hpp"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace sovereign {
+
+class OptionsChain {
+public:
+    /**
+     * Append one strike to the chain. IV is a fraction (0.625 for the
+     * 62.5% the feeds quote), expiry in years, open interest in
+     * contracts. Greeks are garbage until the next recompute().
+     */
+    void add_strike(double strike, double iv, double expiry_years,
+                    bool is_call, double open_interest = 0.0) {
+        if (strike <= 0.0 || iv <= 0.0 || expiry_years <= 0.0) {
+            return;
+        }
+        strikes_.push_back(strike);
+        ivs_.push_back(iv);
+        expiries_.push_back(expiry_years);
+        is_call_.push_back(is_call ? 1 : 0);
+        open_interest_.push_back(open_interest);
+
+        price_.push_back(0.0);
+        delta_.push_back(0.0);
+        gamma_.push_back(0.0);
+        theta_.push_back(0.0);
+        vega_.push_back(0.0);
+        rho_.push_back(0.0);
+    }
+
+    void clear() {
+        strikes_.clear();
+        ivs_.clear();
+        expiries_.clear();
+        is_call_.clear();
+        open_interest_.clear();
+        price_.clear();
+        delta_.clear();
+        gamma_.clear();
+        theta_.clear();
+        vega_.clear();
+        rho_.clear();
+        underlying_ = 0.0;
+    }
+
+    size_t size() const { return strikes_.size(); }
+    double underlying() const { return underlying_; }
+
+    /**
+     * Recompute every Greek in the chain for a new underlying price.
+     * One pass over the SoA arrays - 4 strikes per AVX2 iteration,
+     * scalar tail.
+     */
+    void recompute(double underlying, double rate = 0.0) {
+        if (underlying <= 0.0) {
+            return;
+        }
+        underlying_ = underlying;
+        rate_ = rate;
+
+        size_t n = strikes_.size();
+        size_t i = 0;
+#if defined(__AVX2__)
+        for (; i + 4 <= n; i += 4) {
+            compute_avx2(i, underlying, rate);
+        }
+#endif
+        for (; i < n; ++i) {
+            compute_scalar(i, underlying, rate);
+        }
+    }
+
+    // Per-strike reads (valid after recompute)
+    double strike(size_t i) const { return strikes_[i]; }
+    bool is_call(size_t i) const { return is_call_[i] != 0; }
+    double price(size_t i) const { return price_[i]; }
+    double delta(size_t i) const { return delta_[i]; }
+    double gamma(size_t i) const { return gamma_[i]; }
+    double theta(size_t i) const { return theta_[i]; }
+    double vega(size_t i) const { return vega_[i]; }
+    double rho(size_t i) const { return rho_[i]; }
+
+    /**
+     * Dealer gamma exposure: sum of gamma * open interest * S^2 * 1%,
+     * calls positive, puts negative (the usual dealer-long-calls,
+     * dealer-short-puts convention). Dollar change in dealer hedge
+     * demand per 1% move of the underlying.
+     */
+    double gamma_exposure() const {
+        double total = 0.0;
+        double scale = underlying_ * underlying_ * 0.01;
+        for (size_t i = 0; i < strikes_.size(); ++i) {
+            double g = gamma_[i] * open_interest_[i] * scale;
+            total += is_call_[i] ? g : -g;
+        }
+        return total;
+    }
+
+    /**
+     * Max pain: the expiry price (among listed strikes) minimizing the
+     * total intrinsic payout across all open contracts. O(n^2) over
+     * the chain - runs off the hot path.
+     */
+    double max_pain() const {
+        double best_strike = 0.0;
+        double best_payout = 0.0;
+        bool first = true;
+        for (size_t c = 0; c < strikes_.size(); ++c) {
+            double settle = strikes_[c];
+            double payout = 0.0;
+            for (size_t i = 0; i < strikes_.size(); ++i) {
+                double intrinsic = is_call_[i]
+                    ? std::max(0.0, settle - strikes_[i])
+                    : std::max(0.0, strikes_[i] - settle);
+                payout += intrinsic * open_interest_[i];
+            }
+            if (first || payout < best_payout) {
+                best_payout = payout;
+                best_strike = settle;
+                first = false;
+            }
+        }
+        return best_strike;
+    }
+
+    /**
+     * Push the strike nearest the underlying into the InstrumentCache
+     * OPTIONS slot, so readers of the single-slot API keep seeing live
+     * at-the-money Greeks. IV goes back out as the percentage the
+     * cache stores.
+     */
+    void publish_atm(InstrumentCache& cache, Exchange ex) const {
+        if (strikes_.empty() || underlying_ <= 0.0) {
+            return;
+        }
+        size_t atm = 0;
+        double best_dist = std::abs(strikes_[0] - underlying_);
+        for (size_t i = 1; i < strikes_.size(); ++i) {
+            double dist = std::abs(strikes_[i] - underlying_);
+            if (dist < best_dist) {
+                best_dist = dist;
+                atm = i;
+            }
+        }
+        cache.update_greeks(ex, strikes_[atm], is_call_[atm] != 0,
+                            delta_[atm], gamma_[atm], theta_[atm], vega_[atm],
+                            ivs_[atm] * 100.0);
+    }
+
+private:
+    static constexpr double INV_SQRT_2PI = 0.3989422804014327;
+
+    // Abramowitz-Stegun 26.2.17 coefficients
+    static constexpr double AS_K = 0.2316419;
+    static constexpr double AS_B1 = 0.319381530;
+    static constexpr double AS_B2 = -0.356563782;
+    static constexpr double AS_B3 = 1.781477937;
+    static constexpr double AS_B4 = -1.821255978;
+    static constexpr double AS_B5 = 1.330274429;
+
+    /**
+     * Standard normal CDF, A&S 26.2.17. Same polynomial as the vector
+     * path so scalar tail and AVX2 lanes agree bit-for-bit in spirit.
+     */
+    static double norm_cdf(double x) {
+        double ax = std::abs(x);
+        double k = 1.0 / (1.0 + AS_K * ax);
+        double poly = k * (AS_B1 + k * (AS_B2 + k * (AS_B3 + k * (AS_B4 + k * AS_B5))));
+        double approx = 1.0 - INV_SQRT_2PI * std::exp(-0.5 * ax * ax) * poly;
+        return x >= 0.0 ? approx : 1.0 - approx;
+    }
+
+    void compute_scalar(size_t i, double s, double r) {
+        double k = strikes_[i];
+        double iv = ivs_[i];
+        double t = expiries_[i];
+
+        double sqrt_t = std::sqrt(t);
+        double sig_sqrt_t = iv * sqrt_t;
+        double d1 = (std::log(s / k) + (r + 0.5 * iv * iv) * t) / sig_sqrt_t;
+        double d2 = d1 - sig_sqrt_t;
+
+        double pdf_d1 = INV_SQRT_2PI * std::exp(-0.5 * d1 * d1);
+        double nd1 = norm_cdf(d1);
+        double nd2 = norm_cdf(d2);
+        double disc = std::exp(-r * t);
+
+        gamma_[i] = pdf_d1 / (s * sig_sqrt_t);
+        vega_[i] = s * pdf_d1 * sqrt_t;
+        double theta_common = -s * pdf_d1 * iv / (2.0 * sqrt_t);
+
+        if (is_call_[i]) {
+            price_[i] = s * nd1 - k * disc * nd2;
+            delta_[i] = nd1;
+            theta_[i] = theta_common - r * k * disc * nd2;
+            rho_[i] = k * t * disc * nd2;
+        } else {
+            price_[i] = k * disc * (1.0 - nd2) - s * (1.0 - nd1);
+            delta_[i] = nd1 - 1.0;
+            theta_[i] = theta_common + r * k * disc * (1.0 - nd2);
+            rho_[i] = -k * t * disc * (1.0 - nd2);
+        }
+    }
+
+#if defined(__AVX2__)
+    /**
+     * exp for 4 doubles: split x = n*ln2 + rem, polynomial e^rem on
+     * |rem| <= ln2/2, scale by 2^n through the exponent bits. Accurate
+     * to ~1e-13 over the Greeks' working range.
+     */
+    static inline __m256d exp_pd(__m256d x) noexcept {
+        const __m256d log2e = _mm256_set1_pd(1.4426950408889634);
+        const __m256d ln2_hi = _mm256_set1_pd(0.693145751953125);
+        const __m256d ln2_lo = _mm256_set1_pd(1.42860682030941723212e-06);
+
+        x = _mm256_max_pd(_mm256_set1_pd(-700.0),
+                          _mm256_min_pd(_mm256_set1_pd(700.0), x));
+
+        __m256d n = _mm256_round_pd(_mm256_mul_pd(x, log2e),
+                                    _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        __m256d rem = _mm256_fnmadd_pd(n, ln2_hi, x);
+        rem = _mm256_fnmadd_pd(n, ln2_lo, rem);
+
+        // Degree-10 Taylor of e^rem (Horner)
+        __m256d p = _mm256_set1_pd(1.0 / 3628800.0);
+        p = _mm256_fmadd_pd(p, rem, _mm256_set1_pd(1.0 / 362880.0));
+        p = _mm256_fmadd_pd(p, rem, _mm256_set1_pd(1.0 / 40320.0));
+        p = _mm256_fmadd_pd(p, rem, _mm256_set1_pd(1.0 / 5040.0));
+        p = _mm256_fmadd_pd(p, rem, _mm256_set1_pd(1.0 / 720.0));
+        p = _mm256_fmadd_pd(p, rem, _mm256_set1_pd(1.0 / 120.0));
+        p = _mm256_fmadd_pd(p, rem, _mm256_set1_pd(1.0 / 24.0));
+        p = _mm256_fmadd_pd(p, rem, _mm256_set1_pd(1.0 / 6.0));
+        p = _mm256_fmadd_pd(p, rem, _mm256_set1_pd(0.5));
+        p = _mm256_fmadd_pd(p, rem, _mm256_set1_pd(1.0));
+        p = _mm256_fmadd_pd(p, rem, _mm256_set1_pd(1.0));
+
+        // Scale by 2^n: add n to the biased exponent field
+        __m128i n32 = _mm256_cvtpd_epi32(n);
+        __m256i n64 = _mm256_cvtepi32_epi64(n32);
+        __m256i pow2 = _mm256_slli_epi64(
+            _mm256_add_epi64(n64, _mm256_set1_epi64x(1023)), 52);
+        return _mm256_mul_pd(p, _mm256_castsi256_pd(pow2));
+    }
+
+    /**
+     * log for 4 positive doubles: pull the exponent, atanh series on
+     * the mantissa folded into [sqrt(2)/2, sqrt(2)].
+     */
+    static inline __m256d log_pd(__m256d x) noexcept {
+        const __m256i exp_mask = _mm256_set1_epi64x(0x7FF0000000000000LL);
+        const __m256i mant_mask = _mm256_set1_epi64x(0x000FFFFFFFFFFFFFLL);
+        const __m256i one_bits = _mm256_set1_epi64x(0x3FF0000000000000LL);
+
+        __m256i bits = _mm256_castpd_si256(x);
+        __m256i exp_bits = _mm256_srli_epi64(
+            _mm256_and_si256(bits, exp_mask), 52);
+        __m256d e = _mm256_sub_pd(int64_to_pd(exp_bits), _mm256_set1_pd(1023.0));
+        __m256d m = _mm256_castsi256_pd(
+            _mm256_or_si256(_mm256_and_si256(bits, mant_mask), one_bits));
+
+        // Fold m > sqrt(2) down an octave so |t| stays small
+        __m256d gt = _mm256_cmp_pd(m, _mm256_set1_pd(1.4142135623730951), _CMP_GT_OQ);
+        m = _mm256_blendv_pd(m, _mm256_mul_pd(m, _mm256_set1_pd(0.5)), gt);
+        e = _mm256_add_pd(e, _mm256_and_pd(gt, _mm256_set1_pd(1.0)));
+
+        // ln m = 2 atanh(t), t = (m-1)/(m+1), |t| <= 0.1716
+        __m256d one = _mm256_set1_pd(1.0);
+        __m256d t = _mm256_div_pd(_mm256_sub_pd(m, one), _mm256_add_pd(m, one));
+        __m256d t2 = _mm256_mul_pd(t, t);
+        __m256d p = _mm256_set1_pd(1.0 / 11.0);
+        p = _mm256_fmadd_pd(p, t2, _mm256_set1_pd(1.0 / 9.0));
+        p = _mm256_fmadd_pd(p, t2, _mm256_set1_pd(1.0 / 7.0));
+        p = _mm256_fmadd_pd(p, t2, _mm256_set1_pd(1.0 / 5.0));
+        p = _mm256_fmadd_pd(p, t2, _mm256_set1_pd(1.0 / 3.0));
+        p = _mm256_fmadd_pd(p, t2, one);
+        __m256d ln_m = _mm256_mul_pd(_mm256_set1_pd(2.0), _mm256_mul_pd(t, p));
+
+        return _mm256_fmadd_pd(e, _mm256_set1_pd(0.6931471805599453), ln_m);
+    }
+
+    // Exponent field values fit in 11 bits, so the int32 round-trip is exact
+    static inline __m256d int64_to_pd(__m256i v) noexcept {
+        __m128i lo = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(
+            v, _mm256_setr_epi32(0, 2, 4, 6, 0, 0, 0, 0)));
+        return _mm256_cvtepi32_pd(lo);
+    }
+
+    /**
+     * A&S 26.2.17 normal CDF on 4 lanes, mirrored for negative x.
+     */
+    static inline __m256d norm_cdf_pd(__m256d x) noexcept {
+        const __m256d sign_mask = _mm256_set1_pd(-0.0);
+        __m256d ax = _mm256_andnot_pd(sign_mask, x);
+
+        __m256d k = _mm256_div_pd(_mm256_set1_pd(1.0),
+            _mm256_fmadd_pd(_mm256_set1_pd(AS_K), ax, _mm256_set1_pd(1.0)));
+        __m256d poly = _mm256_set1_pd(AS_B5);
+        poly = _mm256_fmadd_pd(poly, k, _mm256_set1_pd(AS_B4));
+        poly = _mm256_fmadd_pd(poly, k, _mm256_set1_pd(AS_B3));
+        poly = _mm256_fmadd_pd(poly, k, _mm256_set1_pd(AS_B2));
+        poly = _mm256_fmadd_pd(poly, k, _mm256_set1_pd(AS_B1));
+        poly = _mm256_mul_pd(poly, k);
+
+        __m256d pdf = _mm256_mul_pd(_mm256_set1_pd(INV_SQRT_2PI),
+            exp_pd(_mm256_mul_pd(_mm256_set1_pd(-0.5), _mm256_mul_pd(ax, ax))));
+        __m256d approx = _mm256_fnmadd_pd(pdf, poly, _mm256_set1_pd(1.0));
+
+        __m256d neg = _mm256_cmp_pd(x, _mm256_setzero_pd(), _CMP_LT_OQ);
+        return _mm256_blendv_pd(approx,
+            _mm256_sub_pd(_mm256_set1_pd(1.0), approx), neg);
+    }
+
+    /**
+     * Four strikes at once: shared d1/d2/pdf/CDF lanes, call/put
+     * differences resolved with blends on the is_call mask.
+     */
+    void compute_avx2(size_t i, double s, double r) {
+        const __m256d one = _mm256_set1_pd(1.0);
+        __m256d vs = _mm256_set1_pd(s);
+        __m256d vr = _mm256_set1_pd(r);
+
+        __m256d k = _mm256_loadu_pd(&strikes_[i]);
+        __m256d iv = _mm256_loadu_pd(&ivs_[i]);
+        __m256d t = _mm256_loadu_pd(&expiries_[i]);
+
+        __m256d sqrt_t = _mm256_sqrt_pd(t);
+        __m256d sig_sqrt_t = _mm256_mul_pd(iv, sqrt_t);
+        __m256d half_var = _mm256_mul_pd(_mm256_set1_pd(0.5), _mm256_mul_pd(iv, iv));
+        __m256d d1 = _mm256_div_pd(
+            _mm256_fmadd_pd(_mm256_add_pd(vr, half_var), t,
+                            log_pd(_mm256_div_pd(vs, k))),
+            sig_sqrt_t);
+        __m256d d2 = _mm256_sub_pd(d1, sig_sqrt_t);
+
+        __m256d pdf_d1 = _mm256_mul_pd(_mm256_set1_pd(INV_SQRT_2PI),
+            exp_pd(_mm256_mul_pd(_mm256_set1_pd(-0.5), _mm256_mul_pd(d1, d1))));
+        __m256d nd1 = norm_cdf_pd(d1);
+        __m256d nd2 = norm_cdf_pd(d2);
+        __m256d disc = exp_pd(_mm256_mul_pd(
+            _mm256_sub_pd(_mm256_setzero_pd(), vr), t));
+        __m256d k_disc = _mm256_mul_pd(k, disc);
+
+        _mm256_storeu_pd(&gamma_[i],
+            _mm256_div_pd(pdf_d1, _mm256_mul_pd(vs, sig_sqrt_t)));
+        _mm256_storeu_pd(&vega_[i],
+            _mm256_mul_pd(vs, _mm256_mul_pd(pdf_d1, sqrt_t)));
+
+        // Call/put lane mask from the is_call bytes
+        __m256d call_mask = _mm256_cmp_pd(
+            _mm256_setr_pd(is_call_[i], is_call_[i + 1],
+                           is_call_[i + 2], is_call_[i + 3]),
+            _mm256_setzero_pd(), _CMP_GT_OQ);
+
+        __m256d nd1m = _mm256_sub_pd(one, nd1);
+        __m256d nd2m = _mm256_sub_pd(one, nd2);
+
+        __m256d call_price = _mm256_fmsub_pd(vs, nd1, _mm256_mul_pd(k_disc, nd2));
+        __m256d put_price = _mm256_fmsub_pd(k_disc, nd2m, _mm256_mul_pd(vs, nd1m));
+        _mm256_storeu_pd(&price_[i],
+            _mm256_blendv_pd(put_price, call_price, call_mask));
+
+        _mm256_storeu_pd(&delta_[i],
+            _mm256_blendv_pd(_mm256_sub_pd(nd1, one), nd1, call_mask));
+
+        __m256d theta_common = _mm256_div_pd(
+            _mm256_mul_pd(_mm256_sub_pd(_mm256_setzero_pd(), vs),
+                          _mm256_mul_pd(pdf_d1, iv)),
+            _mm256_mul_pd(_mm256_set1_pd(2.0), sqrt_t));
+        __m256d r_k_disc = _mm256_mul_pd(vr, k_disc);
+        __m256d call_theta = _mm256_fnmadd_pd(r_k_disc, nd2, theta_common);
+        __m256d put_theta = _mm256_fmadd_pd(r_k_disc, nd2m, theta_common);
+        _mm256_storeu_pd(&theta_[i],
+            _mm256_blendv_pd(put_theta, call_theta, call_mask));
+
+        __m256d kt_disc = _mm256_mul_pd(k_disc, t);
+        __m256d call_rho = _mm256_mul_pd(kt_disc, nd2);
+        __m256d put_rho = _mm256_sub_pd(_mm256_setzero_pd(),
+                                        _mm256_mul_pd(kt_disc, nd2m));
+        _mm256_storeu_pd(&rho_[i],
+            _mm256_blendv_pd(put_rho, call_rho, call_mask));
+    }
+#endif
+
+    // SoA inputs
+    std::vector<double> strikes_;
+    std::vector<double> ivs_;           // Fractions, not percent
+    std::vector<double> expiries_;      // Years
+    std::vector<uint8_t> is_call_;
+    std::vector<double> open_interest_;
+
+    // SoA outputs, refreshed by recompute()
+    std::vector<double> price_;
+    std::vector<double> delta_;
+    std::vector<double> gamma_;
+    std::vector<double> theta_;
+    std::vector<double> vega_;
+    std::vector<double> rho_;
+
+    double underlying_ = 0.0;
+    double rate_ = 0.0;
+};
+
+} // namespace sovereign
@@ -22,16 +22,72 @@
 #pragma once
 
 #include "order_book_types.hpp"
+#include "level_pool.hpp"
 #include <array>
 #include <shared_mutex>
 #include <mutex>
 #include <functional>
-#include <unordered_map>
 #include <string>
 #include <vector>
 
 namespace sovereign {
 
+// ============================================================================
+// LOCK-FREE BOOK SNAPSHOT (seqlock read path)
+// ============================================================================
+// Fixed-size top-of-book view published through a per-exchange sequence
+// counter. Readers copy it without taking a mutex or allocating, so the
+// signal path can sample thousands of books per second without contending
+// with WebSocket/REST writers.
+// ============================================================================
+
+struct BookSnapshot {
+    // Top-N levels kept lock-free. Deep-book math still uses the locked API.
+    static constexpr size_t DEPTH = 16;
+
+    PriceLevel bids[DEPTH];   // Sorted by price DESCENDING (best bid first)
+    PriceLevel asks[DEPTH];   // Sorted by price ASCENDING (best ask first)
+    uint32_t bid_count = 0;
+    uint32_t ask_count = 0;
+    uint64_t sequence = 0;
+    std::chrono::steady_clock::time_point timestamp;
+
+    bool is_valid() const {
+        return bid_count > 0 && ask_count > 0;
+    }
+
+    double best_bid() const {
+        return bid_count > 0 ? bids[0].price : 0.0;
+    }
+
+    double best_ask() const {
+        return ask_count > 0 ? asks[0].price : 0.0;
+    }
+
+    double spread() const {
+        return best_ask() - best_bid();
+    }
+
+    double spread_pct() const {
+        double bid = best_bid();
+        if (bid <= 0.0) return 0.0;
+        return (best_ask() - bid) / bid * 100.0;
+    }
+
+    double mid_price() const {
+        double bid = best_bid();
+        double ask = best_ask();
+        if (bid <= 0.0 || ask <= 0.0) return 0.0;
+        return (bid + ask) / 2.0;
+    }
+
+    int64_t age_ms() const {
+        auto now = std::chrono::steady_clock::now();
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            now - timestamp).count();
+    }
+};
+
 class OrderBookCache {
 public:
     // Callback type for update notifications
@@ -53,8 +109,8 @@ public:
      * Performance: <500 nanoseconds typical.
      */
     OrderBook get(Exchange exchange) const {
-        size_t idx = static_cast<size_t>(exchange);
-        if (idx >= static_cast<size_t>(Exchange::COUNT)) {
+        size_t idx = exchange_slot(exchange);
+        if (idx >= ENABLED_EXCHANGE_COUNT) {
             return OrderBook{};
         }
         std::shared_lock<std::shared_mutex> lock(mutexes_[idx]);
@@ -64,10 +120,14 @@ public:
     /**
      * Get a reference to bids only (avoids copying asks).
      * Caller must hold the returned lock until done reading.
+     * Exchanges outside the active set get an empty (static) vector.
      */
     std::pair<const std::vector<PriceLevel>&, std::shared_lock<std::shared_mutex>>
     get_bids(Exchange exchange) const {
-        size_t idx = static_cast<size_t>(exchange);
+        size_t idx = exchange_slot(exchange);
+        if (idx >= ENABLED_EXCHANGE_COUNT) {
+            return {empty_levels(), std::shared_lock<std::shared_mutex>()};
+        }
         std::shared_lock<std::shared_mutex> lock(mutexes_[idx]);
         return {books_[idx].bids, std::move(lock)};
     }
@@ -77,7 +137,10 @@ public:
      */
     std::pair<const std::vector<PriceLevel>&, std::shared_lock<std::shared_mutex>>
     get_asks(Exchange exchange) const {
-        size_t idx = static_cast<size_t>(exchange);
+        size_t idx = exchange_slot(exchange);
+        if (idx >= ENABLED_EXCHANGE_COUNT) {
+            return {empty_levels(), std::shared_lock<std::shared_mutex>()};
+        }
         std::shared_lock<std::shared_mutex> lock(mutexes_[idx]);
         return {books_[idx].asks, std::move(lock)};
     }
@@ -86,8 +149,8 @@ public:
      * Check if order book is stale (older than max_age_ms).
      */
     bool is_stale(Exchange exchange, int max_age_ms = 5000) const {
-        size_t idx = static_cast<size_t>(exchange);
-        if (idx >= static_cast<size_t>(Exchange::COUNT)) {
+        size_t idx = exchange_slot(exchange);
+        if (idx >= ENABLED_EXCHANGE_COUNT) {
             return true;
         }
         std::shared_lock<std::shared_mutex> lock(mutexes_[idx]);
@@ -98,8 +161,8 @@ public:
      * Check if order book is valid (has data).
      */
     bool is_valid(Exchange exchange) const {
-        size_t idx = static_cast<size_t>(exchange);
-        if (idx >= static_cast<size_t>(Exchange::COUNT)) {
+        size_t idx = exchange_slot(exchange);
+        if (idx >= ENABLED_EXCHANGE_COUNT) {
             return false;
         }
         std::shared_lock<std::shared_mutex> lock(mutexes_[idx]);
@@ -111,8 +174,8 @@ public:
      * Lock-free read using atomic.
      */
     uint64_t get_sequence(Exchange exchange) const {
-        size_t idx = static_cast<size_t>(exchange);
-        if (idx >= static_cast<size_t>(Exchange::COUNT)) {
+        size_t idx = exchange_slot(exchange);
+        if (idx >= ENABLED_EXCHANGE_COUNT) {
             return 0;
         }
         return sequence_counters_[idx].load(std::memory_order_acquire);
@@ -122,8 +185,8 @@ public:
      * Get best bid price.
      */
     double get_best_bid(Exchange exchange) const {
-        size_t idx = static_cast<size_t>(exchange);
-        if (idx >= static_cast<size_t>(Exchange::COUNT)) {
+        size_t idx = exchange_slot(exchange);
+        if (idx >= ENABLED_EXCHANGE_COUNT) {
             return 0.0;
         }
         std::shared_lock<std::shared_mutex> lock(mutexes_[idx]);
@@ -134,8 +197,8 @@ public:
      * Get best ask price.
      */
     double get_best_ask(Exchange exchange) const {
-        size_t idx = static_cast<size_t>(exchange);
-        if (idx >= static_cast<size_t>(Exchange::COUNT)) {
+        size_t idx = exchange_slot(exchange);
+        if (idx >= ENABLED_EXCHANGE_COUNT) {
             return 0.0;
         }
         std::shared_lock<std::shared_mutex> lock(mutexes_[idx]);
@@ -146,20 +209,79 @@ public:
      * Get total bid depth.
      */
     double get_bid_depth(Exchange exchange, size_t max_levels = 50) const {
-        size_t idx = static_cast<size_t>(exchange);
-        if (idx >= static_cast<size_t>(Exchange::COUNT)) {
+        size_t idx = exchange_slot(exchange);
+        if (idx >= ENABLED_EXCHANGE_COUNT) {
             return 0.0;
         }
         std::shared_lock<std::shared_mutex> lock(mutexes_[idx]);
         return books_[idx].total_bid_depth(max_levels);
     }
 
+    // ========================================================================
+    // LOCK-FREE READ OPERATIONS (seqlock - never block, never allocate)
+    // ========================================================================
+
+    /**
+     * Read the published top-of-book snapshot without taking a mutex.
+     *
+     * Classic seqlock: retry while a writer holds an odd sequence number or
+     * the number changed mid-copy. Writers are staggered per exchange and
+     * hold the odd window for ~100ns, so retries are rare.
+     *
+     * Returns false for an out-of-range exchange or an empty snapshot.
+     * Performance: ~50-100 nanoseconds, no contention with writers.
+     */
+    bool read_snapshot(Exchange exchange, BookSnapshot& out) const {
+        size_t idx = exchange_slot(exchange);
+        if (idx >= ENABLED_EXCHANGE_COUNT) {
+            return false;
+        }
+
+        const auto& version = snapshot_versions_[idx];
+        for (;;) {
+            uint64_t v1 = version.load(std::memory_order_acquire);
+            if (v1 & 1) continue;  // Writer in progress
+
+            out = snapshots_[idx];
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            uint64_t v2 = version.load(std::memory_order_relaxed);
+            if (v1 == v2) break;   // Consistent copy
+        }
+        return out.is_valid();
+    }
+
+    /**
+     * Lock-free best bid (0.0 if no snapshot yet).
+     */
+    double snapshot_best_bid(Exchange exchange) const {
+        BookSnapshot snap;
+        return read_snapshot(exchange, snap) ? snap.best_bid() : 0.0;
+    }
+
+    /**
+     * Lock-free best ask (0.0 if no snapshot yet).
+     */
+    double snapshot_best_ask(Exchange exchange) const {
+        BookSnapshot snap;
+        return read_snapshot(exchange, snap) ? snap.best_ask() : 0.0;
+    }
+
+    /**
+     * Lock-free spread in percent (0.0 if no snapshot yet).
+     */
+    double snapshot_spread_pct(Exchange exchange) const {
+        BookSnapshot snap;
+        return read_snapshot(exchange, snap) ? snap.spread_pct() : 0.0;
+    }
+
     /**
      * Get all order books at once (for monitoring).
+     * Indexed by dense slot; ENABLED_EXCHANGES[i] names entry i.
      */
-    std::array<OrderBook, static_cast<size_t>(Exchange::COUNT)> get_all() const {
-        std::array<OrderBook, static_cast<size_t>(Exchange::COUNT)> result;
-        for (size_t i = 0; i < static_cast<size_t>(Exchange::COUNT); ++i) {
+    std::array<OrderBook, ENABLED_EXCHANGE_COUNT> get_all() const {
+        std::array<OrderBook, ENABLED_EXCHANGE_COUNT> result;
+        for (size_t i = 0; i < ENABLED_EXCHANGE_COUNT; ++i) {
             std::shared_lock<std::shared_mutex> lock(mutexes_[i]);
             result[i] = books_[i];
         }
@@ -176,8 +298,8 @@ public:
      * Automatically updates timestamp and sequence.
      */
     void update(Exchange exchange, OrderBook&& book) {
-        size_t idx = static_cast<size_t>(exchange);
-        if (idx >= static_cast<size_t>(Exchange::COUNT)) {
+        size_t idx = exchange_slot(exchange);
+        if (idx >= ENABLED_EXCHANGE_COUNT) {
             return;
         }
 
@@ -187,10 +309,18 @@ public:
             std::unique_lock<std::shared_mutex> lock(mutexes_[idx]);
             uint64_t new_seq = sequence_counters_[idx].load() + 1;
             sequence_counters_[idx].store(new_seq);
-            book.sequence = new_seq;
-            books_[idx] = std::move(book);
+            // Swap instead of assign so the displaced book's buffers
+            // ride out in `book` for recycling below
+            books_[idx].bids.swap(book.bids);
+            books_[idx].asks.swap(book.asks);
+            books_[idx].timestamp = book.timestamp;
+            books_[idx].sequence = new_seq;
+            publish_snapshot(idx);
         }
 
+        // Recycle the displaced buffers on the writing thread
+        LevelPool::local().release_book(std::move(book));
+
         // Fire callback outside lock
         if (update_callback_) {
             std::shared_lock<std::shared_mutex> lock(mutexes_[idx]);
@@ -202,54 +332,86 @@ public:
      * Update just the bids (for incremental updates).
      */
     void update_bids(Exchange exchange, std::vector<PriceLevel>&& bids) {
-        size_t idx = static_cast<size_t>(exchange);
-        if (idx >= static_cast<size_t>(Exchange::COUNT)) {
+        size_t idx = exchange_slot(exchange);
+        if (idx >= ENABLED_EXCHANGE_COUNT) {
             return;
         }
 
-        std::unique_lock<std::shared_mutex> lock(mutexes_[idx]);
-        books_[idx].bids = std::move(bids);
-        books_[idx].timestamp = std::chrono::steady_clock::now();
-        books_[idx].sequence = sequence_counters_[idx].fetch_add(1) + 1;
+        {
+            std::unique_lock<std::shared_mutex> lock(mutexes_[idx]);
+            books_[idx].bids.swap(bids);
+            books_[idx].timestamp = std::chrono::steady_clock::now();
+            books_[idx].sequence = sequence_counters_[idx].fetch_add(1) + 1;
+            publish_snapshot(idx);
+        }
+        LevelPool::local().release(std::move(bids));
     }
 
     /**
      * Update just the asks (for incremental updates).
      */
     void update_asks(Exchange exchange, std::vector<PriceLevel>&& asks) {
-        size_t idx = static_cast<size_t>(exchange);
-        if (idx >= static_cast<size_t>(Exchange::COUNT)) {
+        size_t idx = exchange_slot(exchange);
+        if (idx >= ENABLED_EXCHANGE_COUNT) {
+            return;
+        }
+
+        {
+            std::unique_lock<std::shared_mutex> lock(mutexes_[idx]);
+            books_[idx].asks.swap(asks);
+            books_[idx].timestamp = std::chrono::steady_clock::now();
+            books_[idx].sequence = sequence_counters_[idx].fetch_add(1) + 1;
+            publish_snapshot(idx);
+        }
+        LevelPool::local().release(std::move(asks));
+    }
+
+    /**
+     * Apply incremental L2 deltas to an exchange book in place.
+     *
+     * This is the hot write path for delta-streaming exchanges (Binance,
+     * OKX, Deribit, ...): a typical 3-5 level message touches only the
+     * affected levels instead of replacing two 100-level vectors.
+     */
+    void apply_deltas(Exchange exchange,
+                      const std::vector<PriceLevel>& bid_deltas,
+                      const std::vector<PriceLevel>& ask_deltas) {
+        size_t idx = exchange_slot(exchange);
+        if (idx >= ENABLED_EXCHANGE_COUNT) {
             return;
         }
 
         std::unique_lock<std::shared_mutex> lock(mutexes_[idx]);
-        books_[idx].asks = std::move(asks);
+        books_[idx].apply_deltas(bid_deltas, ask_deltas);
         books_[idx].timestamp = std::chrono::steady_clock::now();
         books_[idx].sequence = sequence_counters_[idx].fetch_add(1) + 1;
+        publish_snapshot(idx);
     }
 
     /**
      * Clear order book for an exchange.
      */
     void clear(Exchange exchange) {
-        size_t idx = static_cast<size_t>(exchange);
-        if (idx >= static_cast<size_t>(Exchange::COUNT)) {
+        size_t idx = exchange_slot(exchange);
+        if (idx >= ENABLED_EXCHANGE_COUNT) {
             return;
         }
 
         std::unique_lock<std::shared_mutex> lock(mutexes_[idx]);
         books_[idx].clear();
         books_[idx].sequence = sequence_counters_[idx].fetch_add(1) + 1;
+        publish_snapshot(idx);
     }
 
     /**
      * Clear all order books.
      */
     void clear_all() {
-        for (size_t i = 0; i < static_cast<size_t>(Exchange::COUNT); ++i) {
+        for (size_t i = 0; i < ENABLED_EXCHANGE_COUNT; ++i) {
             std::unique_lock<std::shared_mutex> lock(mutexes_[i]);
             books_[i].clear();
             books_[i].sequence = sequence_counters_[i].fetch_add(1) + 1;
+            publish_snapshot(i);
         }
     }
 
@@ -274,7 +436,7 @@ public:
      */
     size_t valid_count() const {
         size_t count = 0;
-        for (size_t i = 0; i < static_cast<size_t>(Exchange::COUNT); ++i) {
+        for (size_t i = 0; i < ENABLED_EXCHANGE_COUNT; ++i) {
             std::shared_lock<std::shared_mutex> lock(mutexes_[i]);
             if (books_[i].is_valid()) {
                 ++count;
@@ -288,7 +450,7 @@ public:
      */
     size_t fresh_count(int max_age_ms = 5000) const {
         size_t count = 0;
-        for (size_t i = 0; i < static_cast<size_t>(Exchange::COUNT); ++i) {
+        for (size_t i = 0; i < ENABLED_EXCHANGE_COUNT; ++i) {
             std::shared_lock<std::shared_mutex> lock(mutexes_[i]);
             if (books_[i].is_valid() && books_[i].age_ms() <= max_age_ms) {
                 ++count;
@@ -301,8 +463,8 @@ public:
      * Print cache status (for debugging).
      */
     void print_status() const {
-        for (size_t i = 0; i < static_cast<size_t>(Exchange::COUNT); ++i) {
-            Exchange ex = static_cast<Exchange>(i);
+        for (size_t i = 0; i < ENABLED_EXCHANGE_COUNT; ++i) {
+            Exchange ex = ENABLED_EXCHANGES[i];
             std::shared_lock<std::shared_mutex> lock(mutexes_[i]);
             const auto& book = books_[i];
 
@@ -321,16 +483,55 @@ public:
 
 private:
     // Per-exchange mutexes (mutable for const read methods)
-    mutable std::array<std::shared_mutex, static_cast<size_t>(Exchange::COUNT)> mutexes_;
+    mutable std::array<std::shared_mutex, ENABLED_EXCHANGE_COUNT> mutexes_;
 
     // Order book storage
-    std::array<OrderBook, static_cast<size_t>(Exchange::COUNT)> books_;
+    std::array<OrderBook, ENABLED_EXCHANGE_COUNT> books_;
 
     // Sequence counters for change detection (atomic for lock-free reads)
-    std::array<std::atomic<uint64_t>, static_cast<size_t>(Exchange::COUNT)> sequence_counters_{};
+    std::array<std::atomic<uint64_t>, ENABLED_EXCHANGE_COUNT> sequence_counters_{};
+
+    // Seqlock-published snapshots (odd version = write in progress)
+    std::array<std::atomic<uint64_t>, ENABLED_EXCHANGE_COUNT> snapshot_versions_{};
+    std::array<BookSnapshot, ENABLED_EXCHANGE_COUNT> snapshots_{};
 
     // Optional update callback
     UpdateCallback update_callback_;
+
+    // Shared fallback for get_bids/get_asks on a disabled exchange
+    static const std::vector<PriceLevel>& empty_levels() {
+        static const std::vector<PriceLevel> empty;
+        return empty;
+    }
+
+    /**
+     * Publish the top of books_[idx] into the lock-free snapshot.
+     * Must be called while holding the writer lock (single writer).
+     */
+    void publish_snapshot(size_t idx) {
+        auto& version = snapshot_versions_[idx];
+        auto& snap = snapshots_[idx];
+        const auto& book = books_[idx];
+
+        // Odd = write in progress. acq_rel keeps the data stores below
+        // from being hoisted above the increment.
+        version.fetch_add(1, std::memory_order_acq_rel);
+
+        snap.bid_count = static_cast<uint32_t>(
+            std::min(book.bids.size(), BookSnapshot::DEPTH));
+        snap.ask_count = static_cast<uint32_t>(
+            std::min(book.asks.size(), BookSnapshot::DEPTH));
+        for (uint32_t i = 0; i < snap.bid_count; ++i) {
+            snap.bids[i] = book.bids[i];
+        }
+        for (uint32_t i = 0; i < snap.ask_count; ++i) {
+            snap.asks[i] = book.asks[i];
+        }
+        snap.sequence = book.sequence;
+        snap.timestamp = book.timestamp;
+
+        version.fetch_add(1, std::memory_order_release);
+    }
 };
 
 
@@ -339,7 +540,8 @@ private:
 // ============================================================================
 // Caches InstrumentData for ALL 7 instrument types across ALL 110 exchanges.
 // Key format: "exchange:instrument_type" (e.g., "binance:perpetual")
-// Thread-safe using std::shared_mutex.
+// Thread-safe using sharded per-exchange std::shared_mutex, so a writer
+// updating one exchange never blocks readers of any other exchange.
 // ============================================================================
 
 class InstrumentCache {
@@ -359,10 +561,11 @@ public:
 
     /**
      * Generate cache key from exchange + instrument type.
-     * Format: "exchange_index:instrument_index"
+     * Format: "exchange_slot:instrument_index" (dense slots, so a subset
+     * build only allocates storage for the active exchanges).
      */
     static size_t make_key(Exchange ex, InstrumentType type) {
-        return static_cast<size_t>(ex) * static_cast<size_t>(InstrumentType::INST_COUNT)
+        return exchange_slot(ex) * static_cast<size_t>(InstrumentType::INST_COUNT)
              + static_cast<size_t>(type);
     }
 
@@ -374,22 +577,52 @@ public:
     }
 
     // ========================================================================
-    // READ OPERATIONS (use shared_lock - multiple readers allowed)
+    // READ OPERATIONS (use shared_lock on the exchange's shard)
     // ========================================================================
 
     /**
      * Get instrument data for exchange + type.
-     * Thread-safe: Uses shared_lock.
+     * Thread-safe: Uses shared_lock on the exchange's shard only.
      * Performance: <1 microsecond typical.
      */
     InstrumentData get(Exchange ex, InstrumentType type) const {
-        size_t key = make_key(ex, type);
-        std::shared_lock<std::shared_mutex> lock(mutex_);
-        auto it = cache_.find(key);
-        if (it != cache_.end()) {
-            return it->second;
+        size_t ex_idx = exchange_slot(ex);
+        if (ex_idx >= ENABLED_EXCHANGE_COUNT) {
+            return InstrumentData{};
+        }
+        std::shared_lock<std::shared_mutex> lock(mutexes_[ex_idx]);
+        return slots_[make_key(ex, type)];
+    }
+
+    /**
+     * Get the hot quote for exchange + type.
+     * Copies only the fixed-size hot header (top QUOTE_LEVELS book levels,
+     * last/mark price, funding, timestamp, sequence) - ~180 bytes with no
+     * allocation, versus the ~2.5KB full InstrumentData copy from get().
+     * Prefer this on every read that does not need Greeks/margin fields.
+     */
+    InstrumentQuote get_quote(Exchange ex, InstrumentType type) const {
+        size_t ex_idx = exchange_slot(ex);
+        if (ex_idx >= ENABLED_EXCHANGE_COUNT) {
+            return InstrumentQuote{};
         }
-        return InstrumentData{};
+        std::shared_lock<std::shared_mutex> lock(mutexes_[ex_idx]);
+        return InstrumentQuote::from(slots_[make_key(ex, type)]);
+    }
+
+    /**
+     * Get the cold extension for exchange + type (Greeks, margin rates,
+     * inverse contract specs, leveraged-token NAV, futures basis).
+     * Fetched separately so the common quote read stays small; pair the
+     * sequence field with get_quote() to detect a write between the two.
+     */
+    InstrumentExtra get_extra(Exchange ex, InstrumentType type) const {
+        size_t ex_idx = exchange_slot(ex);
+        if (ex_idx >= ENABLED_EXCHANGE_COUNT) {
+            return InstrumentExtra{};
+        }
+        std::shared_lock<std::shared_mutex> lock(mutexes_[ex_idx]);
+        return InstrumentExtra::from(slots_[make_key(ex, type)]);
     }
 
     /**
@@ -397,13 +630,16 @@ public:
      */
     std::vector<InstrumentData> get_all_instruments(Exchange ex) const {
         std::vector<InstrumentData> result;
-        std::shared_lock<std::shared_mutex> lock(mutex_);
+        size_t ex_idx = exchange_slot(ex);
+        if (ex_idx >= ENABLED_EXCHANGE_COUNT) {
+            return result;
+        }
+        std::shared_lock<std::shared_mutex> lock(mutexes_[ex_idx]);
 
         for (size_t i = 0; i < static_cast<size_t>(InstrumentType::INST_COUNT); ++i) {
-            size_t key = make_key(ex, static_cast<InstrumentType>(i));
-            auto it = cache_.find(key);
-            if (it != cache_.end() && it->second.is_valid()) {
-                result.push_back(it->second);
+            const auto& data = slots_[make_key(ex, static_cast<InstrumentType>(i))];
+            if (data.is_valid()) {
+                result.push_back(data);
             }
         }
         return result;
@@ -413,142 +649,152 @@ public:
      * Get order book for specific instrument.
      */
     OrderBook get_book(Exchange ex, InstrumentType type) const {
-        std::shared_lock<std::shared_mutex> lock(mutex_);
-        size_t key = make_key(ex, type);
-        auto it = cache_.find(key);
-        if (it != cache_.end()) {
-            return it->second.book;
+        size_t ex_idx = exchange_slot(ex);
+        if (ex_idx >= ENABLED_EXCHANGE_COUNT) {
+            return OrderBook{};
         }
-        return OrderBook{};
+        std::shared_lock<std::shared_mutex> lock(mutexes_[ex_idx]);
+        return slots_[make_key(ex, type)].book;
     }
 
     /**
      * Check if instrument data is stale.
      */
     bool is_stale(Exchange ex, InstrumentType type, int max_age_ms = 5000) const {
-        std::shared_lock<std::shared_mutex> lock(mutex_);
-        size_t key = make_key(ex, type);
-        auto it = cache_.find(key);
-        if (it == cache_.end()) {
+        size_t ex_idx = exchange_slot(ex);
+        if (ex_idx >= ENABLED_EXCHANGE_COUNT) {
             return true;
         }
-        return it->second.age_ms() > max_age_ms;
+        std::shared_lock<std::shared_mutex> lock(mutexes_[ex_idx]);
+        const auto& data = slots_[make_key(ex, type)];
+        if (data.sequence == 0) {
+            return true;  // Never written
+        }
+        return data.age_ms() > max_age_ms;
     }
 
     /**
      * Check if instrument data is fresh (valid and not stale).
      */
     bool is_fresh(Exchange ex, InstrumentType type, int max_age_ms = 5000) const {
-        std::shared_lock<std::shared_mutex> lock(mutex_);
-        size_t key = make_key(ex, type);
-        auto it = cache_.find(key);
-        if (it == cache_.end()) {
+        size_t ex_idx = exchange_slot(ex);
+        if (ex_idx >= ENABLED_EXCHANGE_COUNT) {
             return false;
         }
-        return it->second.is_valid() && it->second.age_ms() <= max_age_ms;
+        std::shared_lock<std::shared_mutex> lock(mutexes_[ex_idx]);
+        const auto& data = slots_[make_key(ex, type)];
+        return data.is_valid() && data.age_ms() <= max_age_ms;
     }
 
     /**
      * Check if exchange supports instrument type.
      */
     bool has_instrument(Exchange ex, InstrumentType type) const {
-        std::shared_lock<std::shared_mutex> lock(mutex_);
-        size_t key = make_key(ex, type);
-        auto it = cache_.find(key);
-        return it != cache_.end() && it->second.is_valid();
+        size_t ex_idx = exchange_slot(ex);
+        if (ex_idx >= ENABLED_EXCHANGE_COUNT) {
+            return false;
+        }
+        std::shared_lock<std::shared_mutex> lock(mutexes_[ex_idx]);
+        return slots_[make_key(ex, type)].is_valid();
     }
 
     /**
      * Get best bid for instrument.
      */
     double get_best_bid(Exchange ex, InstrumentType type) const {
-        std::shared_lock<std::shared_mutex> lock(mutex_);
-        size_t key = make_key(ex, type);
-        auto it = cache_.find(key);
-        if (it != cache_.end()) {
-            return it->second.book.best_bid();
+        size_t ex_idx = exchange_slot(ex);
+        if (ex_idx >= ENABLED_EXCHANGE_COUNT) {
+            return 0.0;
         }
-        return 0.0;
+        std::shared_lock<std::shared_mutex> lock(mutexes_[ex_idx]);
+        return slots_[make_key(ex, type)].book.best_bid();
     }
 
     /**
      * Get best ask for instrument.
      */
     double get_best_ask(Exchange ex, InstrumentType type) const {
-        std::shared_lock<std::shared_mutex> lock(mutex_);
-        size_t key = make_key(ex, type);
-        auto it = cache_.find(key);
-        if (it != cache_.end()) {
-            return it->second.book.best_ask();
+        size_t ex_idx = exchange_slot(ex);
+        if (ex_idx >= ENABLED_EXCHANGE_COUNT) {
+            return 0.0;
         }
-        return 0.0;
+        std::shared_lock<std::shared_mutex> lock(mutexes_[ex_idx]);
+        return slots_[make_key(ex, type)].book.best_ask();
     }
 
     /**
      * Get mark price (for perpetual/futures/inverse).
      */
     double get_mark_price(Exchange ex, InstrumentType type) const {
-        std::shared_lock<std::shared_mutex> lock(mutex_);
-        size_t key = make_key(ex, type);
-        auto it = cache_.find(key);
-        if (it != cache_.end()) {
-            return it->second.mark_price;
+        size_t ex_idx = exchange_slot(ex);
+        if (ex_idx >= ENABLED_EXCHANGE_COUNT) {
+            return 0.0;
         }
-        return 0.0;
+        std::shared_lock<std::shared_mutex> lock(mutexes_[ex_idx]);
+        return slots_[make_key(ex, type)].mark_price;
     }
 
     /**
      * Get funding rate (for perpetual/inverse).
      */
     double get_funding_rate(Exchange ex, InstrumentType type) const {
-        std::shared_lock<std::shared_mutex> lock(mutex_);
-        size_t key = make_key(ex, type);
-        auto it = cache_.find(key);
-        if (it != cache_.end()) {
-            return it->second.funding_rate;
+        size_t ex_idx = exchange_slot(ex);
+        if (ex_idx >= ENABLED_EXCHANGE_COUNT) {
+            return 0.0;
         }
-        return 0.0;
+        std::shared_lock<std::shared_mutex> lock(mutexes_[ex_idx]);
+        return slots_[make_key(ex, type)].funding_rate;
     }
 
     /**
      * Get sequence number for change detection.
+     * Sequences are per-exchange (0 = never written).
      */
     uint64_t get_sequence(Exchange ex, InstrumentType type) const {
-        std::shared_lock<std::shared_mutex> lock(mutex_);
-        size_t key = make_key(ex, type);
-        auto it = cache_.find(key);
-        if (it != cache_.end()) {
-            return it->second.sequence;
+        size_t ex_idx = exchange_slot(ex);
+        if (ex_idx >= ENABLED_EXCHANGE_COUNT) {
+            return 0;
         }
-        return 0;
+        std::shared_lock<std::shared_mutex> lock(mutexes_[ex_idx]);
+        return slots_[make_key(ex, type)].sequence;
     }
 
     // ========================================================================
-    // WRITE OPERATIONS (use unique_lock - single writer)
+    // WRITE OPERATIONS (use unique_lock on the exchange's shard)
     // ========================================================================
 
     /**
      * Update instrument data.
-     * Thread-safe: Uses unique_lock.
+     * Thread-safe: Uses unique_lock on the exchange's shard only, so
+     * concurrent updates to different exchanges never serialize.
      */
     void update(Exchange ex, InstrumentType type, InstrumentData&& data) {
+        size_t ex_idx = exchange_slot(ex);
+        if (ex_idx >= ENABLED_EXCHANGE_COUNT) {
+            return;
+        }
+
         data.type = type;
         data.timestamp = std::chrono::steady_clock::now();
 
         size_t key = make_key(ex, type);
+        std::vector<PriceLevel> displaced_bids, displaced_asks;
         {
-            std::unique_lock<std::shared_mutex> lock(mutex_);
-            data.sequence = ++global_sequence_;
-            cache_[key] = std::move(data);
+            std::unique_lock<std::shared_mutex> lock(mutexes_[ex_idx]);
+            data.sequence = sequence_counters_[ex_idx].fetch_add(1) + 1;
+            // Rescue the displaced book's buffers before the assignment
+            // frees them, then recycle outside the lock
+            displaced_bids = std::move(slots_[key].book.bids);
+            displaced_asks = std::move(slots_[key].book.asks);
+            slots_[key] = std::move(data);
         }
+        LevelPool::local().release(std::move(displaced_bids));
+        LevelPool::local().release(std::move(displaced_asks));
 
         // Fire callback outside lock
         if (update_callback_) {
-            std::shared_lock<std::shared_mutex> lock(mutex_);
-            auto it = cache_.find(key);
-            if (it != cache_.end()) {
-                update_callback_(ex, type, it->second);
-            }
+            std::shared_lock<std::shared_mutex> lock(mutexes_[ex_idx]);
+            update_callback_(ex, type, slots_[key]);
         }
     }
 
@@ -556,16 +802,24 @@ public:
      * Update just the order book for an instrument.
      */
     void update_book(Exchange ex, InstrumentType type, OrderBook&& book) {
-        size_t key = make_key(ex, type);
-        std::unique_lock<std::shared_mutex> lock(mutex_);
-
-        auto& data = cache_[key];
-        data.type = type;
-        data.book = std::move(book);
-        data.book.timestamp = std::chrono::steady_clock::now();
-        data.timestamp = data.book.timestamp;
-        data.last_price = data.book.mid_price();
-        data.sequence = ++global_sequence_;
+        size_t ex_idx = exchange_slot(ex);
+        if (ex_idx >= ENABLED_EXCHANGE_COUNT) {
+            return;
+        }
+        {
+            std::unique_lock<std::shared_mutex> lock(mutexes_[ex_idx]);
+
+            auto& data = slots_[make_key(ex, type)];
+            data.type = type;
+            data.book.bids.swap(book.bids);
+            data.book.asks.swap(book.asks);
+            data.book.sequence = book.sequence;
+            data.book.timestamp = std::chrono::steady_clock::now();
+            data.timestamp = data.book.timestamp;
+            data.last_price = data.book.mid_price();
+            data.sequence = sequence_counters_[ex_idx].fetch_add(1) + 1;
+        }
+        LevelPool::local().release_book(std::move(book));
     }
 
     /**
@@ -573,15 +827,18 @@ public:
      */
     void update_funding(Exchange ex, InstrumentType type,
                         double funding_rate, int64_t next_funding_ts) {
-        size_t key = make_key(ex, type);
-        std::unique_lock<std::shared_mutex> lock(mutex_);
+        size_t ex_idx = exchange_slot(ex);
+        if (ex_idx >= ENABLED_EXCHANGE_COUNT) {
+            return;
+        }
+        std::unique_lock<std::shared_mutex> lock(mutexes_[ex_idx]);
 
-        auto& data = cache_[key];
+        auto& data = slots_[make_key(ex, type)];
         data.type = type;
         data.funding_rate = funding_rate;
         data.next_funding_ts = next_funding_ts;
         data.timestamp = std::chrono::steady_clock::now();
-        data.sequence = ++global_sequence_;
+        data.sequence = sequence_counters_[ex_idx].fetch_add(1) + 1;
     }
 
     /**
@@ -589,17 +846,20 @@ public:
      */
     void update_mark_price(Exchange ex, InstrumentType type,
                            double mark_price, double index_price = 0.0) {
-        size_t key = make_key(ex, type);
-        std::unique_lock<std::shared_mutex> lock(mutex_);
+        size_t ex_idx = exchange_slot(ex);
+        if (ex_idx >= ENABLED_EXCHANGE_COUNT) {
+            return;
+        }
+        std::unique_lock<std::shared_mutex> lock(mutexes_[ex_idx]);
 
-        auto& data = cache_[key];
+        auto& data = slots_[make_key(ex, type)];
         data.type = type;
         data.mark_price = mark_price;
         if (index_price > 0) {
             data.index_price = index_price;
         }
         data.timestamp = std::chrono::steady_clock::now();
-        data.sequence = ++global_sequence_;
+        data.sequence = sequence_counters_[ex_idx].fetch_add(1) + 1;
     }
 
     /**
@@ -608,10 +868,13 @@ public:
     void update_greeks(Exchange ex, double strike, bool is_call,
                        double delta, double gamma, double theta, double vega,
                        double implied_vol = 0.0) {
-        size_t key = make_key(ex, InstrumentType::OPTIONS);
-        std::unique_lock<std::shared_mutex> lock(mutex_);
+        size_t ex_idx = exchange_slot(ex);
+        if (ex_idx >= ENABLED_EXCHANGE_COUNT) {
+            return;
+        }
+        std::unique_lock<std::shared_mutex> lock(mutexes_[ex_idx]);
 
-        auto& data = cache_[key];
+        auto& data = slots_[make_key(ex, InstrumentType::OPTIONS)];
         data.type = InstrumentType::OPTIONS;
         data.strike = strike;
         data.is_call = is_call;
@@ -623,21 +886,25 @@ public:
             data.implied_vol = implied_vol;
         }
         data.timestamp = std::chrono::steady_clock::now();
-        data.sequence = ++global_sequence_;
+        data.sequence = sequence_counters_[ex_idx].fetch_add(1) + 1;
     }
 
     /**
      * Batch update multiple instruments.
      */
     void update_batch(Exchange ex, std::vector<InstrumentData>&& instruments) {
-        std::unique_lock<std::shared_mutex> lock(mutex_);
+        size_t ex_idx = exchange_slot(ex);
+        if (ex_idx >= ENABLED_EXCHANGE_COUNT) {
+            return;
+        }
+        std::unique_lock<std::shared_mutex> lock(mutexes_[ex_idx]);
         auto now = std::chrono::steady_clock::now();
 
         for (auto& data : instruments) {
             data.timestamp = now;
-            data.sequence = ++global_sequence_;
+            data.sequence = sequence_counters_[ex_idx].fetch_add(1) + 1;
             size_t key = make_key(ex, data.type);
-            cache_[key] = std::move(data);
+            slots_[key] = std::move(data);
         }
     }
 
@@ -645,19 +912,25 @@ public:
      * Clear instrument data for exchange + type.
      */
     void clear(Exchange ex, InstrumentType type) {
-        size_t key = make_key(ex, type);
-        std::unique_lock<std::shared_mutex> lock(mutex_);
-        cache_.erase(key);
+        size_t ex_idx = exchange_slot(ex);
+        if (ex_idx >= ENABLED_EXCHANGE_COUNT) {
+            return;
+        }
+        std::unique_lock<std::shared_mutex> lock(mutexes_[ex_idx]);
+        slots_[make_key(ex, type)] = InstrumentData{};
     }
 
     /**
      * Clear all instruments for an exchange.
      */
     void clear_exchange(Exchange ex) {
-        std::unique_lock<std::shared_mutex> lock(mutex_);
+        size_t ex_idx = exchange_slot(ex);
+        if (ex_idx >= ENABLED_EXCHANGE_COUNT) {
+            return;
+        }
+        std::unique_lock<std::shared_mutex> lock(mutexes_[ex_idx]);
         for (size_t i = 0; i < static_cast<size_t>(InstrumentType::INST_COUNT); ++i) {
-            size_t key = make_key(ex, static_cast<InstrumentType>(i));
-            cache_.erase(key);
+            slots_[make_key(ex, static_cast<InstrumentType>(i))] = InstrumentData{};
         }
     }
 
@@ -665,8 +938,13 @@ public:
      * Clear all cached data.
      */
     void clear_all() {
-        std::unique_lock<std::shared_mutex> lock(mutex_);
-        cache_.clear();
+        for (size_t ex_idx = 0; ex_idx < ENABLED_EXCHANGE_COUNT; ++ex_idx) {
+            std::unique_lock<std::shared_mutex> lock(mutexes_[ex_idx]);
+            for (size_t i = 0; i < static_cast<size_t>(InstrumentType::INST_COUNT); ++i) {
+                slots_[make_key(ENABLED_EXCHANGES[ex_idx],
+                                static_cast<InstrumentType>(i))] = InstrumentData{};
+            }
+        }
     }
 
     // ========================================================================
@@ -685,23 +963,34 @@ public:
     // ========================================================================
 
     /**
-     * Get total number of cached instruments.
+     * Get total number of cached instruments (entries ever written).
      */
     size_t size() const {
-        std::shared_lock<std::shared_mutex> lock(mutex_);
-        return cache_.size();
+        size_t count = 0;
+        for (size_t ex_idx = 0; ex_idx < ENABLED_EXCHANGE_COUNT; ++ex_idx) {
+            std::shared_lock<std::shared_mutex> lock(mutexes_[ex_idx]);
+            for (size_t i = 0; i < static_cast<size_t>(InstrumentType::INST_COUNT); ++i) {
+                if (slots_[make_key(ENABLED_EXCHANGES[ex_idx],
+                                    static_cast<InstrumentType>(i))].sequence != 0) {
+                    ++count;
+                }
+            }
+        }
+        return count;
     }
 
     /**
      * Get number of valid instruments for an exchange.
      */
     size_t instrument_count(Exchange ex) const {
-        std::shared_lock<std::shared_mutex> lock(mutex_);
+        size_t ex_idx = exchange_slot(ex);
+        if (ex_idx >= ENABLED_EXCHANGE_COUNT) {
+            return 0;
+        }
+        std::shared_lock<std::shared_mutex> lock(mutexes_[ex_idx]);
         size_t count = 0;
         for (size_t i = 0; i < static_cast<size_t>(InstrumentType::INST_COUNT); ++i) {
-            size_t key = make_key(ex, static_cast<InstrumentType>(i));
-            auto it = cache_.find(key);
-            if (it != cache_.end() && it->second.is_valid()) {
+            if (slots_[make_key(ex, static_cast<InstrumentType>(i))].is_valid()) {
                 ++count;
             }
         }
@@ -712,11 +1001,15 @@ public:
      * Get number of fresh instruments across all exchanges.
      */
     size_t fresh_count(int max_age_ms = 5000) const {
-        std::shared_lock<std::shared_mutex> lock(mutex_);
         size_t count = 0;
-        for (const auto& [key, data] : cache_) {
-            if (data.is_valid() && data.age_ms() <= max_age_ms) {
-                ++count;
+        for (size_t ex_idx = 0; ex_idx < ENABLED_EXCHANGE_COUNT; ++ex_idx) {
+            std::shared_lock<std::shared_mutex> lock(mutexes_[ex_idx]);
+            for (size_t i = 0; i < static_cast<size_t>(InstrumentType::INST_COUNT); ++i) {
+                const auto& data = slots_[make_key(ENABLED_EXCHANGES[ex_idx],
+                                                   static_cast<InstrumentType>(i))];
+                if (data.is_valid() && data.age_ms() <= max_age_ms) {
+                    ++count;
+                }
             }
         }
         return count;
@@ -726,22 +1019,20 @@ public:
      * Print cache status (for debugging).
      */
     void print_status() const {
-        std::shared_lock<std::shared_mutex> lock(mutex_);
-        printf("[INSTRUMENT CACHE] Total: %zu entries\n", cache_.size());
+        printf("[INSTRUMENT CACHE] Total: %zu entries\n", size());
 
-        for (size_t ex_idx = 0; ex_idx < static_cast<size_t>(Exchange::COUNT); ++ex_idx) {
-            Exchange ex = static_cast<Exchange>(ex_idx);
+        for (size_t ex_idx = 0; ex_idx < ENABLED_EXCHANGE_COUNT; ++ex_idx) {
+            Exchange ex = ENABLED_EXCHANGES[ex_idx];
+            std::shared_lock<std::shared_mutex> lock(mutexes_[ex_idx]);
             bool has_any = false;
 
             for (size_t inst_idx = 0; inst_idx < static_cast<size_t>(InstrumentType::INST_COUNT); ++inst_idx) {
-                size_t key = make_key(ex, static_cast<InstrumentType>(inst_idx));
-                auto it = cache_.find(key);
-                if (it != cache_.end() && it->second.is_valid()) {
+                const auto& data = slots_[make_key(ex, static_cast<InstrumentType>(inst_idx))];
+                if (data.is_valid()) {
                     if (!has_any) {
                         printf("  %s:\n", exchange_name(ex));
                         has_any = true;
                     }
-                    const auto& data = it->second;
                     printf("    %s: $%.2f | bid=$%.2f ask=$%.2f | age=%ldms\n",
                            instrument_name(data.type),
                            data.last_price,
@@ -754,14 +1045,18 @@ public:
     }
 
 private:
-    // Single mutex for entire cache (simpler than per-key locking)
-    mutable std::shared_mutex mutex_;
+    static constexpr size_t TOTAL_SLOTS =
+        ENABLED_EXCHANGE_COUNT * static_cast<size_t>(InstrumentType::INST_COUNT);
+
+    // Per-exchange shard locks (mutable for const read methods)
+    mutable std::array<std::shared_mutex, ENABLED_EXCHANGE_COUNT> mutexes_;
 
-    // Cache storage: key = (exchange_idx * INST_COUNT + inst_idx)
-    std::unordered_map<size_t, InstrumentData> cache_;
+    // Fixed slot storage indexed by make_key(). A default-constructed
+    // entry (sequence == 0) means "never written" - the old map-absence case.
+    std::array<InstrumentData, TOTAL_SLOTS> slots_;
 
-    // Global sequence counter for change detection
-    uint64_t global_sequence_ = 0;
+    // Per-exchange sequence counters for change detection
+    std::array<std::atomic<uint64_t>, ENABLED_EXCHANGE_COUNT> sequence_counters_{};
 
     // Optional update callback
     UpdateCallback update_callback_;
@@ -180,13 +180,65 @@ inline const char* exchange_name(Exchange ex) {
     return EXCHANGE_NAMES[static_cast<size_t>(ex)];
 }
 
-inline Exchange exchange_from_name(const std::string& name) {
+// ============================================================================
+// NAME -> EXCHANGE LOOKUP (compile-time hash table)
+// ============================================================================
+// exchange_from_name() runs on every BlockchainSignal, and a linear scan
+// with string compares over all 110 names costs ~50 compares on average.
+// Instead the names are hashed into an open-addressing table built at
+// compile time: one FNV-1a pass, a probe, one confirming compare.
+// ============================================================================
+
+constexpr uint64_t fnv1a_hash(const char* s, size_t len) {
+    uint64_t h = 1469598103934665603ULL;
+    for (size_t i = 0; i < len; ++i) {
+        h ^= static_cast<uint8_t>(s[i]);
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+constexpr size_t cx_strlen(const char* s) {
+    size_t n = 0;
+    while (s[n] != '\0') ++n;
+    return n;
+}
+
+// 256 slots for 110 names (~43% load), 0xFF = empty. Linear probing -
+// the table is never full, so every probe chain terminates.
+constexpr size_t EXCHANGE_NAME_TABLE_SIZE = 256;
+
+constexpr std::array<uint8_t, EXCHANGE_NAME_TABLE_SIZE> build_exchange_name_table() {
+    std::array<uint8_t, EXCHANGE_NAME_TABLE_SIZE> table{};
+    for (auto& slot : table) {
+        slot = 0xFF;
+    }
     for (size_t i = 0; i < static_cast<size_t>(Exchange::COUNT); ++i) {
-        if (name == EXCHANGE_NAMES[i]) {
-            return static_cast<Exchange>(i);
+        const char* name = EXCHANGE_NAMES[i];
+        size_t idx = fnv1a_hash(name, cx_strlen(name)) & (EXCHANGE_NAME_TABLE_SIZE - 1);
+        while (table[idx] != 0xFF) {
+            idx = (idx + 1) & (EXCHANGE_NAME_TABLE_SIZE - 1);
         }
+        table[idx] = static_cast<uint8_t>(i);
+    }
+    return table;
+}
+
+inline constexpr std::array<uint8_t, EXCHANGE_NAME_TABLE_SIZE> EXCHANGE_NAME_TABLE =
+    build_exchange_name_table();
+
+inline Exchange exchange_from_name(const std::string& name) {
+    size_t idx = fnv1a_hash(name.data(), name.size()) & (EXCHANGE_NAME_TABLE_SIZE - 1);
+    for (;;) {
+        uint8_t slot = EXCHANGE_NAME_TABLE[idx];
+        if (slot == 0xFF) {
+            return Exchange::COUNT;  // Invalid
+        }
+        if (name == EXCHANGE_NAMES[slot]) {
+            return static_cast<Exchange>(slot);
+        }
+        idx = (idx + 1) & (EXCHANGE_NAME_TABLE_SIZE - 1);
     }
-    return Exchange::COUNT;  // Invalid
 }
 
 // Check if exchange has perpetuals (first 58 in enum)
@@ -194,6 +246,118 @@ inline bool has_perpetuals(Exchange ex) {
     return static_cast<size_t>(ex) <= static_cast<size_t>(Exchange::ZEBPAY);
 }
 
+// ============================================================================
+// COMPILE-TIME EXCHANGE SUBSET
+// ============================================================================
+// A deployment typically trades against ~15 of the 110 exchanges, yet every
+// per-exchange array (cache books, shard mutexes, seqlock snapshots, curl
+// handles) was sized Exchange::COUNT and every monitoring scan walked all
+// 110 slots. Building with an explicit list:
+//
+//     cmake -DEXCHANGE_SUBSET="BINANCE;BYBIT;OKX;KRAKEN;COINBASE"
+//
+// defines SOVEREIGN_EXCHANGES=BINANCE,BYBIT,... and shrinks all of that to
+// the active set at compile time. Enabled exchanges get dense storage slots
+// in enum order via exchange_slot(); disabled ones map past the end, so the
+// existing `idx >= bound` guards reject them and every accessor degrades to
+// its empty/zero result. On-disk and shared-memory formats deliberately stay
+// full-width (they are read by other builds).
+//
+// Default (macro unset): all exchanges enabled, slot == enum value, and the
+// constant-folded mapping compiles to exactly the old code.
+// ============================================================================
+
+namespace subset_detail {
+
+#ifdef SOVEREIGN_EXCHANGES
+// `using enum` lets the macro carry bare enumerator names (BINANCE,BYBIT,...)
+using enum Exchange;
+inline constexpr Exchange LISTED[] = { SOVEREIGN_EXCHANGES };
+#endif
+
+constexpr std::array<bool, static_cast<size_t>(Exchange::COUNT)> build_enabled_mask() {
+    std::array<bool, static_cast<size_t>(Exchange::COUNT)> mask{};
+#ifdef SOVEREIGN_EXCHANGES
+    for (Exchange ex : LISTED) {
+        mask[static_cast<size_t>(ex)] = true;
+    }
+#else
+    for (bool& enabled : mask) {
+        enabled = true;
+    }
+#endif
+    return mask;
+}
+
+inline constexpr auto ENABLED_MASK = build_enabled_mask();
+
+constexpr size_t count_enabled() {
+    size_t n = 0;
+    for (bool enabled : ENABLED_MASK) {
+        if (enabled) ++n;
+    }
+    return n;
+}
+
+} // namespace subset_detail
+
+// Number of exchanges compiled into this binary - sizes every per-exchange
+// array in the hot path.
+inline constexpr size_t ENABLED_EXCHANGE_COUNT = subset_detail::count_enabled();
+
+static_assert(ENABLED_EXCHANGE_COUNT > 0,
+              "SOVEREIGN_EXCHANGES must list at least one exchange");
+
+// True when the exchange is part of this build's active set.
+constexpr bool exchange_enabled(Exchange ex) {
+    size_t idx = static_cast<size_t>(ex);
+    return idx < static_cast<size_t>(Exchange::COUNT) && subset_detail::ENABLED_MASK[idx];
+}
+
+namespace subset_detail {
+
+constexpr std::array<Exchange, ENABLED_EXCHANGE_COUNT> build_enabled_list() {
+    std::array<Exchange, ENABLED_EXCHANGE_COUNT> list{};
+    size_t n = 0;
+    for (size_t i = 0; i < static_cast<size_t>(Exchange::COUNT); ++i) {
+        if (ENABLED_MASK[i]) {
+            list[n++] = static_cast<Exchange>(i);
+        }
+    }
+    return list;
+}
+
+// Dense slot per exchange; disabled entries map to ENABLED_EXCHANGE_COUNT so
+// the standard out-of-range guards reject them.
+constexpr std::array<uint8_t, static_cast<size_t>(Exchange::COUNT)> build_slot_map() {
+    std::array<uint8_t, static_cast<size_t>(Exchange::COUNT)> slots{};
+    size_t n = 0;
+    for (size_t i = 0; i < static_cast<size_t>(Exchange::COUNT); ++i) {
+        slots[i] = static_cast<uint8_t>(ENABLED_MASK[i] ? n++ : ENABLED_EXCHANGE_COUNT);
+    }
+    return slots;
+}
+
+inline constexpr auto SLOT_MAP = build_slot_map();
+
+} // namespace subset_detail
+
+// The active set in enum order - scan loops iterate this instead of all 110
+// enum values, and ENABLED_EXCHANGES[slot] inverts exchange_slot().
+inline constexpr std::array<Exchange, ENABLED_EXCHANGE_COUNT> ENABLED_EXCHANGES =
+    subset_detail::build_enabled_list();
+
+// Dense storage slot for an exchange. Returns ENABLED_EXCHANGE_COUNT for a
+// disabled or out-of-range exchange, which every `idx >= bound` guard treats
+// exactly like the old `idx >= Exchange::COUNT` case.
+constexpr size_t exchange_slot(Exchange ex) {
+    size_t idx = static_cast<size_t>(ex);
+    if (idx >= static_cast<size_t>(Exchange::COUNT)) {
+        return ENABLED_EXCHANGE_COUNT;
+    }
+    return subset_detail::SLOT_MAP[idx];
+}
+
 // ============================================================================
 // INSTRUMENT TYPES - ALL 7 TRADING INSTRUMENTS
 // ============================================================================
@@ -257,11 +421,18 @@ struct ExchangeConfig {
     bool has_perpetual;
     int max_leverage;
     double fee_pct;
+
+    // REST polling policy (see PollScheduler): base refresh interval and
+    // per-minute request budget. Defaults fit mid-tier venues; cases
+    // below override where a venue throttles hard or moves fast.
+    int poll_interval_ms = 500;
+    int rate_limit_per_min = 60;
 };
 
-// Static configuration for ALL exchanges - PURE DATA from CCXT/docs
-// Using inline function to avoid large static array
-inline ExchangeConfig get_exchange_config(Exchange ex) {
+// Static configuration for ALL exchanges - PURE DATA from CCXT/docs.
+// The switch is the single source of truth; it only runs at compile
+// time to populate EXCHANGE_CONFIGS below.
+constexpr ExchangeConfig make_exchange_config(Exchange ex) {
     switch (ex) {
         // ============ PERPETUAL EXCHANGES ============
         case Exchange::APEX:
@@ -281,7 +452,7 @@ inline ExchangeConfig get_exchange_config(Exchange ex) {
                     "BTC/USD:BTC", "BTC/USDT", true, true, 100, 0.002};
         case Exchange::BINANCE:
             return {ex, "wss://fstream.binance.com/ws", "https://fapi.binance.com/fapi/v1/depth?symbol=BTCUSDT&limit=50",
-                    "BTC/USDT:USDT", "BTC/USDT", true, true, 125, 0.001};
+                    "BTC/USDT:USDT", "BTC/USDT", true, true, 125, 0.001, 250, 240};
         case Exchange::BINANCECOINM:
             return {ex, "wss://dstream.binance.com/ws", "https://dapi.binance.com/dapi/v1/depth?symbol=BTCUSD_PERP&limit=50",
                     "BTC/USD:BTC", "BTC/USD", true, true, 125, 0.001};
@@ -437,7 +608,7 @@ inline ExchangeConfig get_exchange_config(Exchange ex) {
                     "BTC/USDT:USDT", "BTC/USDT", true, true, 125, 0.002};
         case Exchange::ZEBPAY:
             return {ex, "", "https://www.zebapi.com/pro/v1/market/BTC-USDT/orderbook",
-                    "BTC/USDT:USDT", "BTC/USDT", false, true, 75, 0.005};
+                    "BTC/USDT:USDT", "BTC/USDT", false, true, 75, 0.005, 2000, 30};  // 3-4s responses through the proxy
 
         // ============ SPOT-ONLY EXCHANGES ============
         case Exchange::ALPACA:
@@ -538,7 +709,7 @@ inline ExchangeConfig get_exchange_config(Exchange ex) {
                     "", "BTC/IDR", true, false, 1, 0.003};
         case Exchange::KRAKEN:
             return {ex, "wss://ws.kraken.com", "https://api.kraken.com/0/public/Depth?pair=XBTUSD&count=50",
-                    "", "BTC/USD", true, false, 1, 0.002};
+                    "", "BTC/USD", true, false, 1, 0.002, 1000, 45};  // Public Depth throttles hard
         case Exchange::KUCOIN:
             return {ex, "wss://ws-api-spot.kucoin.com", "https://api.kucoin.com/api/v1/market/orderbook/level2_100?symbol=BTC-USDT",
                     "", "BTC/USDT", true, false, 1, 0.002};
@@ -589,7 +760,7 @@ inline ExchangeConfig get_exchange_config(Exchange ex) {
                     "", "BTC/USDT", true, false, 1, 0.002};
         case Exchange::YOBIT:
             return {ex, "", "https://yobit.net/api/3/depth/btc_usdt",
-                    "", "BTC/USDT", false, false, 1, 0.002};
+                    "", "BTC/USDT", false, false, 1, 0.002, 5000, 20};  // Thin book, rarely moves
         case Exchange::ZAIF:
             return {ex, "wss://ws.zaif.jp/stream", "https://api.zaif.jp/api/1/depth/btc_jpy",
                     "", "BTC/JPY", true, false, 1, 0.002};
@@ -602,8 +773,29 @@ inline ExchangeConfig get_exchange_config(Exchange ex) {
     }
 }
 
+// All configs hoisted into one constexpr table so the hot callers
+// (TradeDecision::leverage() runs per decision) index it directly
+// instead of executing a 110-case switch returning by value.
+inline constexpr std::array<ExchangeConfig, static_cast<size_t>(Exchange::COUNT) + 1>
+    EXCHANGE_CONFIGS = []() {
+        std::array<ExchangeConfig, static_cast<size_t>(Exchange::COUNT) + 1> configs{};
+        for (size_t i = 0; i <= static_cast<size_t>(Exchange::COUNT); ++i) {
+            configs[i] = make_exchange_config(static_cast<Exchange>(i));
+        }
+        return configs;
+    }();
+
+// Out-of-range indices map to the sentinel slot (the switch default)
+inline const ExchangeConfig& get_exchange_config(Exchange ex) {
+    size_t idx = static_cast<size_t>(ex);
+    if (idx > static_cast<size_t>(Exchange::COUNT)) {
+        idx = static_cast<size_t>(Exchange::COUNT);
+    }
+    return EXCHANGE_CONFIGS[idx];
+}
+
 // Legacy function for compatibility
-inline const ExchangeConfig get_config(Exchange ex) {
+inline const ExchangeConfig& get_config(Exchange ex) {
     return get_exchange_config(ex);
 }
 
@@ -638,6 +830,11 @@ struct OrderBook {
         asks.reserve(MAX_BOOK_LEVELS);
     }
 
+    // Tag constructor that skips the reservation, for callers that
+    // install recycled buffers instead (see LevelPool)
+    struct NoReserve {};
+    explicit OrderBook(NoReserve) {}
+
     // Allow copy and move (needed for cache operations)
     OrderBook(const OrderBook&) = default;
     OrderBook& operator=(const OrderBook&) = default;
@@ -709,6 +906,66 @@ struct OrderBook {
         asks.clear();
         timestamp = std::chrono::steady_clock::time_point{};
     }
+
+    // ========================================================================
+    // INCREMENTAL DELTA UPDATES
+    // ========================================================================
+    // Exchanges like Binance, OKX and Deribit stream L2 deltas: a handful of
+    // (price, new_volume) changes per message. Applying them in place keeps
+    // the hot write path at a few level shifts instead of rebuilding and
+    // re-sorting a full 100-level book per message.
+    // ========================================================================
+
+    /**
+     * Apply one (price, new_volume) change to the bid side in place.
+     * volume == 0 deletes the level. DESCENDING sort order is maintained.
+     */
+    void apply_bid_delta(double price, double volume) {
+        apply_delta(bids, price, volume, /*descending=*/true);
+    }
+
+    /**
+     * Apply one (price, new_volume) change to the ask side in place.
+     * volume == 0 deletes the level. ASCENDING sort order is maintained.
+     */
+    void apply_ask_delta(double price, double volume) {
+        apply_delta(asks, price, volume, /*descending=*/false);
+    }
+
+    /**
+     * Apply a batch of deltas to both sides (typical stream message: 3-5
+     * levels). Deltas are (price, new_volume) pairs reusing PriceLevel.
+     */
+    void apply_deltas(const std::vector<PriceLevel>& bid_deltas,
+                      const std::vector<PriceLevel>& ask_deltas) {
+        for (const auto& d : bid_deltas) apply_bid_delta(d.price, d.volume);
+        for (const auto& d : ask_deltas) apply_ask_delta(d.price, d.volume);
+    }
+
+private:
+    static void apply_delta(std::vector<PriceLevel>& levels,
+                            double price, double volume, bool descending) {
+        // Binary search for the level (books stay sorted at all times)
+        auto it = descending
+            ? std::lower_bound(levels.begin(), levels.end(), price,
+                  [](const PriceLevel& l, double p) { return l.price > p; })
+            : std::lower_bound(levels.begin(), levels.end(), price,
+                  [](const PriceLevel& l, double p) { return l.price < p; });
+
+        if (it != levels.end() && it->price == price) {
+            if (volume > 0.0) {
+                it->volume = volume;   // Update existing level in place
+            } else {
+                levels.erase(it);      // Volume 0 = level removed
+            }
+        } else if (volume > 0.0) {
+            levels.insert(it, PriceLevel{price, volume});
+            if (levels.size() > MAX_BOOK_LEVELS) {
+                levels.pop_back();     // Drop the worst level, keep capacity
+            }
+        }
+        // Delete of an unknown level is a no-op (stale delta)
+    }
 };
 
 // ============================================================================
@@ -786,6 +1043,172 @@ struct InstrumentData {
     double spread_pct() const { return book.spread_pct(); }
 };
 
+// ============================================================================
+// INSTRUMENT QUOTE - Hot header of InstrumentData for cheap reads
+// ============================================================================
+// InstrumentData drags a full OrderBook (two 100-level vectors) plus ~30
+// doubles of Greeks/margin/NAV through every copy - ~2.5KB and two heap
+// allocations even when the caller only wants best bid/ask. The quote is
+// the fixed-size hot subset: top book levels, last/mark price, funding,
+// timestamp, sequence. ~180 bytes, no allocation, one memcpy-class copy.
+
+// Top-of-book depth carried in a quote (4 levels covers impact sizing
+// for the position sizes we trade; deeper walks use get_book())
+constexpr size_t QUOTE_LEVELS = 4;
+
+struct InstrumentQuote {
+    InstrumentType type = InstrumentType::SPOT;
+    uint8_t bid_count = 0;              // Levels actually filled (<= QUOTE_LEVELS)
+    uint8_t ask_count = 0;
+
+    PriceLevel bids[QUOTE_LEVELS];      // Best bid first
+    PriceLevel asks[QUOTE_LEVELS];      // Best ask first
+
+    double last_price = 0.0;
+    double mark_price = 0.0;
+    double funding_rate = 0.0;
+
+    std::chrono::steady_clock::time_point timestamp;
+    uint64_t sequence = 0;              // Matches the InstrumentData it was cut from
+
+    // Validation (mirrors InstrumentData::is_valid)
+    bool is_valid() const {
+        return bid_count > 0 && ask_count > 0 && last_price > 0;
+    }
+
+    // Age check
+    int64_t age_ms() const {
+        auto now = std::chrono::steady_clock::now();
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            now - timestamp).count();
+    }
+
+    double best_bid() const { return bid_count > 0 ? bids[0].price : 0.0; }
+    double best_ask() const { return ask_count > 0 ? asks[0].price : 0.0; }
+
+    double mid_price() const {
+        double bid = best_bid();
+        double ask = best_ask();
+        if (bid <= 0.0 || ask <= 0.0) return 0.0;
+        return (bid + ask) / 2.0;
+    }
+
+    double spread_pct() const {
+        double bid = best_bid();
+        if (bid <= 0.0) return 0.0;
+        return (best_ask() - bid) / bid * 100.0;
+    }
+
+    // Cut the hot header out of full instrument data
+    static InstrumentQuote from(const InstrumentData& data) {
+        InstrumentQuote q;
+        q.type = data.type;
+        q.bid_count = static_cast<uint8_t>(
+            std::min(QUOTE_LEVELS, data.book.bids.size()));
+        q.ask_count = static_cast<uint8_t>(
+            std::min(QUOTE_LEVELS, data.book.asks.size()));
+        for (uint8_t i = 0; i < q.bid_count; ++i) q.bids[i] = data.book.bids[i];
+        for (uint8_t i = 0; i < q.ask_count; ++i) q.asks[i] = data.book.asks[i];
+        q.last_price = data.last_price;
+        q.mark_price = data.mark_price;
+        q.funding_rate = data.funding_rate;
+        q.timestamp = data.timestamp;
+        q.sequence = data.sequence;
+        return q;
+    }
+};
+
+// The whole point of the quote is that it stays small
+static_assert(sizeof(InstrumentQuote) < 200,
+              "InstrumentQuote must stay under 200 bytes - cold fields belong in InstrumentExtra");
+
+// ============================================================================
+// INSTRUMENT EXTRA - Cold extension of InstrumentData, fetched separately
+// ============================================================================
+// Everything the hot path does not need: Greeks, margin rates, inverse
+// contract specs, leveraged-token NAV, futures basis. Callers that want
+// these (options pricing, funding arb) pay for the copy explicitly.
+
+struct InstrumentExtra {
+    InstrumentType type = InstrumentType::SPOT;
+
+    // PERPETUAL + FUTURES pricing context
+    double index_price = 0.0;
+    int64_t next_funding_ts = 0;
+    double predicted_funding = 0.0;
+
+    // FUTURES
+    int64_t expiration_ts = 0;
+    double basis = 0.0;
+    double basis_rate = 0.0;
+
+    // OPTIONS
+    double strike = 0.0;
+    double implied_vol = 0.0;
+    bool is_call = true;
+    double delta = 0.0;
+    double gamma = 0.0;
+    double theta = 0.0;
+    double vega = 0.0;
+    double rho = 0.0;
+    double underlying_price = 0.0;
+    double time_to_expiry = 0.0;
+
+    // MARGIN
+    double interest_rate_long = 0.0;
+    double interest_rate_short = 0.0;
+    double max_leverage = 1.0;
+    double maintenance_margin = 0.0;
+
+    // INVERSE
+    double contract_size = 1.0;
+    double contract_value = 0.0;
+
+    // LEVERAGED TOKEN
+    double nav = 0.0;
+    double real_leverage = 0.0;
+    double target_leverage = 3.0;
+    int64_t rebalance_ts = 0;
+    double basket = 0.0;
+
+    uint64_t sequence = 0;              // Matches the InstrumentData it was cut from
+
+    // Cut the cold extension out of full instrument data
+    static InstrumentExtra from(const InstrumentData& data) {
+        InstrumentExtra e;
+        e.type = data.type;
+        e.index_price = data.index_price;
+        e.next_funding_ts = data.next_funding_ts;
+        e.predicted_funding = data.predicted_funding;
+        e.expiration_ts = data.expiration_ts;
+        e.basis = data.basis;
+        e.basis_rate = data.basis_rate;
+        e.strike = data.strike;
+        e.implied_vol = data.implied_vol;
+        e.is_call = data.is_call;
+        e.delta = data.delta;
+        e.gamma = data.gamma;
+        e.theta = data.theta;
+        e.vega = data.vega;
+        e.rho = data.rho;
+        e.underlying_price = data.underlying_price;
+        e.time_to_expiry = data.time_to_expiry;
+        e.interest_rate_long = data.interest_rate_long;
+        e.interest_rate_short = data.interest_rate_short;
+        e.max_leverage = data.max_leverage;
+        e.maintenance_margin = data.maintenance_margin;
+        e.contract_size = data.contract_size;
+        e.contract_value = data.contract_value;
+        e.nav = data.nav;
+        e.real_leverage = data.real_leverage;
+        e.target_leverage = data.target_leverage;
+        e.rebalance_ts = data.rebalance_ts;
+        e.basket = data.basket;
+        e.sequence = data.sequence;
+        return e;
+    }
+};
+
 // ============================================================================
 // INSTRUMENT CONFIG - Per-instrument symbol configuration
 // ============================================================================
@@ -23,3 +23,34 @@ void print_exchange_info();
 void benchmark_impact_calculator(int iterations = 100000);
 
 } // namespace sovereign
+
+// ============================================================================
+// C API - SHARED-MEMORY BOOK ACCESS
+// ============================================================================
+// For external consumers (Python via ctypes, other C programs) attaching
+// read-only to the segment published by orderbook_service --shm.
+// ============================================================================
+
+extern "C" {
+
+// Attach read-only to a book segment (NULL name = default segment).
+// Returns an opaque handle, or NULL if the segment is missing or its
+// layout version does not match this library build.
+void* sovereign_shm_attach(const char* name);
+
+// Copy one book out of the segment. bids/asks receive up to max_levels
+// [price, volume] pairs each (2 * max_levels doubles per array);
+// *bid_count / *ask_count get the number of levels written. sequence
+// and age_ms are optional (may be NULL). Returns 1 on success, 0 if
+// the exchange index is invalid or the book was never published.
+int sovereign_shm_read_book(void* handle, int exchange_index,
+                            double* bids, int* bid_count,
+                            double* asks, int* ask_count,
+                            int max_levels,
+                            unsigned long long* sequence,
+                            long long* age_ms);
+
+// Detach and free the handle.
+void sovereign_shm_detach(void* handle);
+
+} // extern "C"
@@ -0,0 +1,299 @@
+/**
+ * Adaptive REST Polling Scheduler
+ *
+ * PURE DATA. NO MOCK. MATH NEVER LIES.
+ *
+ * One global polling interval either hammers rate-limited venues or
+ * lets liquid ones go stale - Kraken throttles us at the same cadence
+ * that polls Yobit pointlessly often. This scheduler keeps per-exchange
+ * state instead:
+ *
+ * - Base interval and request budget come from ExchangeConfig
+ *   (poll_interval_ms / rate_limit_per_min), overridable at runtime.
+ * - The interval tightens while top-of-book is actually moving (mid
+ *   price delta between successful polls) and widens after a run of
+ *   quiet polls; errors back off exponentially.
+ * - A token bucket enforces the per-minute budget no matter how tight
+ *   the adaptive interval gets.
+ * - A min-heap on next-poll time drives fetch order, so the REST
+ *   budget concentrates freshness where prices are moving.
+ *
+ * Every public method takes an explicit time point (defaulting to
+ * steady_clock::now()) so the adaptation logic is testable without
+ * real sleeps.
+ */
+
+#pragma once
+
+#include "order_book_types.hpp"
+#include "order_book_cache.hpp"
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <mutex>
+#include <queue>
+#include <vector>
+
+namespace sovereign {
+
+class PollScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr size_t NUM_EXCHANGES = ENABLED_EXCHANGE_COUNT;
+
+    // Adaptation policy
+    static constexpr double MOVE_THRESHOLD_PCT = 0.01;  // Mid move that counts as "busy"
+    static constexpr int QUIET_POLLS = 4;               // Quiet streak before widening
+    static constexpr int MIN_INTERVAL_FLOOR_MS = 100;   // Never poll faster than this
+    static constexpr int MAX_INTERVAL_FACTOR = 16;      // Backoff ceiling = base * this
+
+    explicit PollScheduler(OrderBookCache& cache) : cache_(cache) {}
+
+    /**
+     * Register an exchange. Base interval and budget are pulled from
+     * its ExchangeConfig; first poll is due immediately.
+     */
+    void add(Exchange ex, Clock::time_point now = Clock::now()) {
+        size_t idx = exchange_slot(ex);
+        if (idx >= NUM_EXCHANGES) return;
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        const auto& config = get_exchange_config(ex);
+        Slot& slot = slots_[idx];
+        slot.registered = true;
+        apply_base_interval(slot, config.poll_interval_ms);
+        apply_budget(slot, config.rate_limit_per_min);
+        slot.tokens = slot.token_cap;  // Start with a full bucket
+        slot.last_refill = now;
+        slot.next_poll = now;
+        heap_.push(Entry{now, static_cast<uint16_t>(idx)});
+    }
+
+    /**
+     * Override the base polling interval for one exchange (resets the
+     * adaptive interval to the new base).
+     */
+    void set_base_interval(Exchange ex, int ms, Clock::time_point now = Clock::now()) {
+        size_t idx = exchange_slot(ex);
+        if (idx >= NUM_EXCHANGES || ms <= 0) return;
+        std::lock_guard<std::mutex> lock(mutex_);
+        Slot& slot = slots_[idx];
+        if (!slot.registered) return;
+        apply_base_interval(slot, ms);
+        slot.next_poll = now;
+        heap_.push(Entry{now, static_cast<uint16_t>(idx)});
+    }
+
+    /**
+     * Override the request budget (requests per minute) for one exchange.
+     */
+    void set_budget(Exchange ex, int requests_per_min) {
+        size_t idx = exchange_slot(ex);
+        if (idx >= NUM_EXCHANGES || requests_per_min <= 0) return;
+        std::lock_guard<std::mutex> lock(mutex_);
+        Slot& slot = slots_[idx];
+        if (!slot.registered) return;
+        apply_budget(slot, requests_per_min);
+    }
+
+    /**
+     * Collect the exchanges due for a poll, in next-poll order.
+     * Exchanges whose token bucket is empty are deferred until a token
+     * accrues (counted as throttled), not dropped.
+     *
+     * Each dispatched exchange is pre-rescheduled one interval out, so
+     * a completion that never arrives cannot stall its slot; on_result
+     * replaces that estimate with the adapted one.
+     *
+     * @return Number of exchanges appended to `out`
+     */
+    size_t collect_due(std::vector<Exchange>& out, size_t max_batch = 16,
+                       Clock::time_point now = Clock::now()) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        size_t emitted = 0;
+
+        while (emitted < max_batch && !heap_.empty()) {
+            Entry top = heap_.top();
+            if (top.when > now) break;
+            heap_.pop();
+
+            Slot& slot = slots_[top.idx];
+            if (!slot.registered || top.when != slot.next_poll) {
+                continue;  // Stale entry superseded by a reschedule
+            }
+
+            refill_tokens(slot, now);
+            if (slot.tokens < 1.0) {
+                // Budget exhausted - defer until a token accrues
+                int wait_ms = static_cast<int>(
+                    (1.0 - slot.tokens) / slot.tokens_per_ms) + 1;
+                reschedule(slot, top.idx, now, wait_ms);
+                ++throttled_;
+                continue;
+            }
+
+            slot.tokens -= 1.0;
+            reschedule(slot, top.idx, now, slot.interval_ms);
+            out.push_back(ENABLED_EXCHANGES[top.idx]);
+            ++dispatched_;
+            ++emitted;
+        }
+        return emitted;
+    }
+
+    /**
+     * Report the outcome of a dispatched poll and adapt the interval:
+     * errors double it, a moving mid halves it, a quiet streak widens
+     * it by half. Unregistered exchanges are ignored, so callers can
+     * report every completion unconditionally.
+     */
+    void on_result(Exchange ex, bool success, Clock::time_point now = Clock::now()) {
+        size_t idx = exchange_slot(ex);
+        if (idx >= NUM_EXCHANGES) return;
+        std::lock_guard<std::mutex> lock(mutex_);
+        Slot& slot = slots_[idx];
+        if (!slot.registered) return;
+
+        if (!success) {
+            ++errors_;
+            ++slot.error_streak;
+            slot.quiet_streak = 0;
+            slot.interval_ms = std::min(slot.interval_ms * 2, slot.max_interval_ms);
+        } else {
+            slot.error_streak = 0;
+
+            // Movement detection: compare the cache's mid against the
+            // one seen after the previous successful poll
+            double mid = 0.0;
+            BookSnapshot snap;
+            if (cache_.read_snapshot(ex, snap) && snap.is_valid()) {
+                mid = (snap.best_bid() + snap.best_ask()) / 2.0;
+            }
+            bool first = slot.last_mid <= 0.0;
+            double moved_pct = (!first && mid > 0.0)
+                ? std::fabs(mid - slot.last_mid) / slot.last_mid * 100.0
+                : 0.0;
+            slot.last_mid = mid;
+
+            if (!first && moved_pct >= MOVE_THRESHOLD_PCT) {
+                slot.quiet_streak = 0;
+                slot.interval_ms = std::max(slot.interval_ms / 2, slot.min_interval_ms);
+            } else if (++slot.quiet_streak >= QUIET_POLLS) {
+                slot.quiet_streak = 0;
+                slot.interval_ms = std::min(slot.interval_ms * 3 / 2, slot.max_interval_ms);
+            }
+        }
+
+        reschedule(slot, static_cast<uint16_t>(idx), now, slot.interval_ms);
+    }
+
+    /**
+     * Milliseconds until the earliest scheduled poll, clamped to
+     * [1, 1000] so the poll thread stays responsive to stop().
+     */
+    int ms_until_next(Clock::time_point now = Clock::now()) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        while (!heap_.empty()) {
+            const Entry& top = heap_.top();
+            const Slot& slot = slots_[top.idx];
+            if (!slot.registered || top.when != slot.next_poll) {
+                heap_.pop();  // Prune stale entries while we are here
+                continue;
+            }
+            if (top.when <= now) return 1;
+            auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(
+                top.when - now).count();
+            return wait > 1000 ? 1000 : static_cast<int>(wait);
+        }
+        return 1000;
+    }
+
+    // Current adaptive interval (for monitoring; 0 if not registered)
+    int current_interval_ms(Exchange ex) const {
+        size_t idx = exchange_slot(ex);
+        if (idx >= NUM_EXCHANGES) return 0;
+        std::lock_guard<std::mutex> lock(mutex_);
+        return slots_[idx].registered ? slots_[idx].interval_ms : 0;
+    }
+
+    // Counters for monitoring scheduling efficiency
+    uint64_t dispatch_count() const { return dispatched_; }
+    uint64_t throttle_count() const { return throttled_; }
+    uint64_t error_count() const { return errors_; }
+
+    void print_status() const {
+        printf("[POLL] dispatched=%lu throttled=%lu errors=%lu\n",
+               dispatched_, throttled_, errors_);
+    }
+
+private:
+    struct Slot {
+        bool registered = false;
+        int base_interval_ms = 500;
+        int interval_ms = 500;          // Current adaptive interval
+        int min_interval_ms = 125;
+        int max_interval_ms = 8000;
+        Clock::time_point next_poll;    // Only the entry matching this is live
+        double last_mid = 0.0;
+        int quiet_streak = 0;
+        int error_streak = 0;
+
+        // Token bucket for the per-minute budget
+        double tokens = 1.0;
+        double tokens_per_ms = 1.0 / 1000.0;
+        double token_cap = 1.0;
+        Clock::time_point last_refill;
+    };
+
+    // Min-heap entry; stale entries (when != slot.next_poll) are
+    // discarded lazily on pop instead of being removed in place
+    struct Entry {
+        Clock::time_point when;
+        uint16_t idx;
+        bool operator>(const Entry& other) const { return when > other.when; }
+    };
+
+    static void apply_base_interval(Slot& slot, int ms) {
+        slot.base_interval_ms = ms;
+        slot.interval_ms = ms;
+        slot.min_interval_ms = std::max(ms / 4, MIN_INTERVAL_FLOOR_MS);
+        slot.max_interval_ms = ms * MAX_INTERVAL_FACTOR;
+        slot.quiet_streak = 0;
+        slot.error_streak = 0;
+    }
+
+    static void apply_budget(Slot& slot, int requests_per_min) {
+        slot.tokens_per_ms = static_cast<double>(requests_per_min) / 60000.0;
+        // Allow a ~5 second burst, but always at least one request
+        slot.token_cap = std::max(1.0, static_cast<double>(requests_per_min) / 12.0);
+        if (slot.tokens > slot.token_cap) slot.tokens = slot.token_cap;
+    }
+
+    void refill_tokens(Slot& slot, Clock::time_point now) {
+        auto elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            now - slot.last_refill).count();
+        if (elapsed_ms <= 0) return;
+        slot.tokens = std::min(slot.token_cap,
+                               slot.tokens + elapsed_ms * slot.tokens_per_ms);
+        slot.last_refill = now;
+    }
+
+    void reschedule(Slot& slot, uint16_t idx, Clock::time_point now, int delay_ms) {
+        slot.next_poll = now + std::chrono::milliseconds(delay_ms);
+        heap_.push(Entry{slot.next_poll, idx});
+    }
+
+    OrderBookCache& cache_;
+    mutable std::mutex mutex_;
+
+    std::array<Slot, NUM_EXCHANGES> slots_{};
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap_;
+
+    uint64_t dispatched_ = 0;
+    uint64_t throttled_ = 0;
+    uint64_t errors_ = 0;
+};
+
+} // namespace sovereign
@@ -16,14 +16,20 @@
  * - INVERSE: /inverse/depth or /dapi/v1/depth
  * - LEVERAGED_TOKEN: Same as SPOT with token symbol
  *
- * Uses libcurl for HTTP and simdjson for nanosecond JSON parsing.
+ * Uses libcurl for HTTP (curl_multi for parallel refresh across all
+ * exchanges) and simdjson for nanosecond JSON parsing.
  */
 
 #pragma once
 
 #include "order_book_types.hpp"
 #include "order_book_cache.hpp"
+#include "level_pool.hpp"
+#include "poll_scheduler.hpp"
+#include "simdjson_parsers.hpp"
+#include "cpu_affinity.hpp"
 #include <curl/curl.h>
+#include <array>
 #include <string>
 #include <thread>
 #include <atomic>
@@ -54,10 +60,19 @@ public:
             curl_easy_setopt(curl_, CURLOPT_USERAGENT, "SovereignTrader/1.0");
             curl_easy_setopt(curl_, CURLOPT_PROXY, "http://141.147.58.130:8888");
         }
+        multi_ = curl_multi_init();
     }
 
     ~RESTClient() {
         stop();
+        for (size_t i = 0; i < ENABLED_EXCHANGE_COUNT; ++i) {
+            if (easy_handles_[i]) {
+                curl_easy_cleanup(easy_handles_[i]);
+            }
+        }
+        if (multi_) {
+            curl_multi_cleanup(multi_);
+        }
         if (curl_) {
             curl_easy_cleanup(curl_);
         }
@@ -94,10 +109,23 @@ public:
     bool is_running() const { return running_.load(); }
 
     /**
-     * Set polling interval in milliseconds.
+     * Set the upper bound on the poll thread's nap between scheduler
+     * passes. Per-exchange cadence lives in the PollScheduler; this
+     * legacy knob only caps how long the loop sleeps at once.
      */
     void set_polling_interval(int ms) { polling_interval_ms_ = ms; }
 
+    /**
+     * Access the polling scheduler (to tune per-exchange intervals or
+     * budgets at runtime, or to read dispatch/throttle counters).
+     */
+    PollScheduler& scheduler() { return scheduler_; }
+
+    /**
+     * Set maximum number of transfers in flight for fetch_many().
+     */
+    void set_max_concurrent(size_t n) { max_concurrent_ = n > 0 ? n : 1; }
+
     /**
      * Manually fetch order book for an exchange (blocking).
      * Returns true on success.
@@ -133,10 +161,12 @@ public:
             return false;
         }
 
-        // Parse response
-        OrderBook book;
+        // Parse response into a pooled book (update() recycles the
+        // displaced buffers back to this thread's pool)
+        OrderBook book = LevelPool::local().acquire_book();
         if (!parse_response(exchange, response_buffer_, book)) {
             fprintf(stderr, "[REST] %s parse failed\n", exchange_name(exchange));
+            LevelPool::local().release_book(std::move(book));
             return false;
         }
 
@@ -146,33 +176,115 @@ public:
     }
 
     /**
-     * Fetch all configured REST exchanges.
+     * Fetch many exchanges in parallel using curl_multi.
+     *
+     * Up to max_concurrent_ transfers run at once over per-exchange
+     * keep-alive connections, so one slow endpoint (Zebpay through the
+     * proxy regularly takes 3-4s) no longer stalls the whole refresh
+     * cycle. Each completed response is parsed and pushed into the
+     * cache as soon as it arrives, not when the batch finishes.
+     *
+     * Returns the number of exchanges successfully updated.
+     */
+    size_t fetch_many(const std::vector<Exchange>& exchanges) {
+        if (!multi_) return 0;
+
+        // Build the pending list (skip exchanges without a REST URL)
+        std::vector<size_t> pending;
+        pending.reserve(exchanges.size());
+        for (Exchange ex : exchanges) {
+            size_t idx = exchange_slot(ex);
+            if (idx >= ENABLED_EXCHANGE_COUNT) continue;
+            if (strlen(get_config(ex).rest_url) == 0) continue;
+            pending.push_back(idx);
+        }
+
+        size_t next = 0;
+        size_t in_flight = 0;
+        size_t succeeded = 0;
+
+        // Keep the multi handle topped up to the concurrency limit
+        auto launch_pending = [&]() {
+            while (in_flight < max_concurrent_ && next < pending.size()) {
+                size_t idx = pending[next++];
+                CURL* easy = get_easy_handle(idx);
+                if (!easy) continue;
+                multi_buffers_[idx].clear();
+                curl_easy_setopt(easy, CURLOPT_URL,
+                                 get_config(ENABLED_EXCHANGES[idx]).rest_url);
+                curl_multi_add_handle(multi_, easy);
+                ++in_flight;
+            }
+        };
+
+        launch_pending();
+
+        while (in_flight > 0) {
+            int still_running = 0;
+            if (curl_multi_perform(multi_, &still_running) != CURLM_OK) {
+                break;
+            }
+
+            // Harvest completed transfers and refill the window
+            int msgs_left = 0;
+            while (CURLMsg* msg = curl_multi_info_read(multi_, &msgs_left)) {
+                if (msg->msg != CURLMSG_DONE) continue;
+
+                CURL* easy = msg->easy_handle;
+                char* priv = nullptr;
+                curl_easy_getinfo(easy, CURLINFO_PRIVATE, &priv);
+                size_t idx = reinterpret_cast<uintptr_t>(priv);
+
+                CURLcode result = msg->data.result;
+                curl_multi_remove_handle(multi_, easy);
+                --in_flight;
+
+                if (handle_completion(ENABLED_EXCHANGES[idx], result)) {
+                    ++succeeded;
+                }
+                launch_pending();
+            }
+
+            if (in_flight > 0) {
+                int numfds = 0;
+                curl_multi_wait(multi_, nullptr, 0, 100, &numfds);
+            }
+        }
+
+        return succeeded;
+    }
+
+    /**
+     * Fetch all configured REST exchanges (parallel).
      */
     void fetch_all() {
-        for (size_t i = 0; i < static_cast<size_t>(Exchange::COUNT); ++i) {
-            Exchange ex = static_cast<Exchange>(i);
-            const auto& config = get_config(ex);
+        std::vector<Exchange> targets;
+        for (size_t i = 0; i < ENABLED_EXCHANGE_COUNT; ++i) {
+            Exchange ex = ENABLED_EXCHANGES[i];
 
             // Fetch if REST URL is configured
-            if (strlen(config.rest_url) > 0) {
-                fetch(ex);
+            if (strlen(get_config(ex).rest_url) > 0) {
+                targets.push_back(ex);
             }
         }
+        fetch_many(targets);
     }
 
     /**
-     * Fetch only REST-only exchanges (no WebSocket).
+     * Fetch only REST-only exchanges (no WebSocket), in parallel.
      */
     void fetch_rest_only() {
-        for (size_t i = 0; i < static_cast<size_t>(Exchange::COUNT); ++i) {
-            Exchange ex = static_cast<Exchange>(i);
+        std::vector<Exchange> targets;
+        for (size_t i = 0; i < ENABLED_EXCHANGE_COUNT; ++i) {
+            Exchange ex = ENABLED_EXCHANGES[i];
             const auto& config = get_config(ex);
 
             // Only fetch if no WebSocket (REST-only)
             if (!config.has_websocket && strlen(config.rest_url) > 0) {
-                fetch(ex);
+                targets.push_back(ex);
             }
         }
+        fetch_many(targets);
     }
 
     // ========================================================================
@@ -250,8 +362,8 @@ public:
      * Fetch specific instrument from all exchanges.
      */
     void fetch_instrument_all_exchanges(InstrumentType inst_type) {
-        for (size_t i = 0; i < static_cast<size_t>(Exchange::COUNT); ++i) {
-            Exchange ex = static_cast<Exchange>(i);
+        for (size_t i = 0; i < ENABLED_EXCHANGE_COUNT; ++i) {
+            Exchange ex = ENABLED_EXCHANGES[i];
             const auto& instruments = get_exchange_instruments(ex);
             if (instruments.has(inst_type)) {
                 fetch_instrument(ex, inst_type);
@@ -272,10 +384,20 @@ private:
     CURL* curl_ = nullptr;
     std::string response_buffer_;
 
+    // curl_multi engine: per-exchange easy handles kept alive across
+    // cycles so connections are reused (TLS + TCP keep-alive)
+    CURLM* multi_ = nullptr;
+    std::array<CURL*, ENABLED_EXCHANGE_COUNT> easy_handles_{};
+    std::array<std::string, ENABLED_EXCHANGE_COUNT> multi_buffers_;
+    size_t max_concurrent_ = 16;
+
     std::thread poll_thread_;
     std::atomic<bool> running_{false};
     int polling_interval_ms_ = 500;
 
+    // Per-exchange adaptive scheduling for the background poll loop
+    PollScheduler scheduler_{cache_};
+
     // libcurl write callback
     static size_t write_callback(char* ptr, size_t size, size_t nmemb, void* userdata) {
         std::string* buffer = static_cast<std::string*>(userdata);
@@ -284,11 +406,100 @@ private:
         return total;
     }
 
-    // Background polling loop
+    /**
+     * Get (lazily creating) the persistent easy handle for an exchange.
+     * Each handle keeps its own response buffer and connection.
+     */
+    CURL* get_easy_handle(size_t idx) {
+        if (easy_handles_[idx]) {
+            return easy_handles_[idx];
+        }
+
+        CURL* easy = curl_easy_init();
+        if (!easy) return nullptr;
+
+        curl_easy_setopt(easy, CURLOPT_WRITEFUNCTION, write_callback);
+        curl_easy_setopt(easy, CURLOPT_WRITEDATA, &multi_buffers_[idx]);
+        curl_easy_setopt(easy, CURLOPT_TIMEOUT, 10L);
+        curl_easy_setopt(easy, CURLOPT_CONNECTTIMEOUT, 5L);
+        curl_easy_setopt(easy, CURLOPT_FOLLOWLOCATION, 1L);
+        curl_easy_setopt(easy, CURLOPT_SSL_VERIFYPEER, 1L);
+        curl_easy_setopt(easy, CURLOPT_USERAGENT, "SovereignTrader/1.0");
+        curl_easy_setopt(easy, CURLOPT_PROXY, "http://141.147.58.130:8888");
+        curl_easy_setopt(easy, CURLOPT_TCP_KEEPALIVE, 1L);
+        curl_easy_setopt(easy, CURLOPT_PRIVATE,
+                         reinterpret_cast<char*>(static_cast<uintptr_t>(idx)));
+
+        easy_handles_[idx] = easy;
+        return easy;
+    }
+
+    /**
+     * Handle one completed curl_multi transfer: check result and HTTP
+     * status, parse the response and push it into the cache. The
+     * outcome also feeds the scheduler (no-op for exchanges it does
+     * not manage) so polled venues adapt their cadence.
+     */
+    bool handle_completion(Exchange exchange, CURLcode result) {
+        bool ok = process_completion(exchange, result);
+        scheduler_.on_result(exchange, ok);
+        return ok;
+    }
+
+    bool process_completion(Exchange exchange, CURLcode result) {
+        size_t idx = exchange_slot(exchange);
+        CURL* easy = easy_handles_[idx];
+
+        if (result != CURLE_OK) {
+            fprintf(stderr, "[REST] %s fetch failed: %s\n",
+                    exchange_name(exchange), curl_easy_strerror(result));
+            return false;
+        }
+
+        long http_code = 0;
+        curl_easy_getinfo(easy, CURLINFO_RESPONSE_CODE, &http_code);
+        if (http_code != 200) {
+            fprintf(stderr, "[REST] %s HTTP %ld\n",
+                    exchange_name(exchange), http_code);
+            return false;
+        }
+
+        OrderBook book = LevelPool::local().acquire_book();
+        if (!parse_response(exchange, multi_buffers_[idx], book)) {
+            fprintf(stderr, "[REST] %s parse failed\n", exchange_name(exchange));
+            LevelPool::local().release_book(std::move(book));
+            return false;
+        }
+
+        cache_.update(exchange, std::move(book));
+        return true;
+    }
+
+    // Background polling loop: the scheduler decides which exchanges
+    // are due and in what order; fetch_many() runs the due batch and
+    // reports each completion back through handle_completion
     void poll_loop() {
+        ThreadTopology::instance().pin_current(ThreadRole::REST_POLL);
+
+        // Register every REST-only exchange once; cadence and budget
+        // come from its ExchangeConfig
+        for (size_t i = 0; i < ENABLED_EXCHANGE_COUNT; ++i) {
+            Exchange ex = ENABLED_EXCHANGES[i];
+            const auto& config = get_config(ex);
+            if (!config.has_websocket && strlen(config.rest_url) > 0) {
+                scheduler_.add(ex);
+            }
+        }
+
+        std::vector<Exchange> due;
         while (running_.load()) {
-            fetch_rest_only();
-            std::this_thread::sleep_for(std::chrono::milliseconds(polling_interval_ms_));
+            due.clear();
+            if (scheduler_.collect_due(due, max_concurrent_) > 0) {
+                fetch_many(due);
+            }
+            int nap_ms = scheduler_.ms_until_next();
+            if (nap_ms > polling_interval_ms_) nap_ms = polling_interval_ms_;
+            std::this_thread::sleep_for(std::chrono::milliseconds(nap_ms));
         }
     }
 
@@ -297,8 +508,17 @@ private:
      * Exchange-specific parsing logic.
      */
     bool parse_response(Exchange exchange, const std::string& json, OrderBook& book) {
-        // For now, use simple parsing
-        // TODO: Replace with simdjson for nanosecond performance
+#if HAS_SIMDJSON
+        // Fast path: simdjson covers every shape the scalar parsers
+        // below handle, except Phemex's scaled Ep integers and
+        // Bitfinex's signed [price,count,amount] triples.
+        if (exchange != Exchange::PHEMEX && exchange != Exchange::BITFINEX &&
+            simd_parse::parse_book(json, book)) {
+            return true;
+        }
+        book.bids.clear();
+        book.asks.clear();
+#endif
 
         switch (exchange) {
             case Exchange::COINBASE: return parse_generic_array(json, book);
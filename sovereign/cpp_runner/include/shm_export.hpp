@@ -0,0 +1,281 @@
+/**
+ * Shared-Memory Order Book Export
+ *
+ * PURE DATA. NO MOCK. MATH NEVER LIES.
+ *
+ * Publishes the OrderBookCache into a named POSIX shared-memory segment
+ * so co-located processes (the Python trader, blockchain_runner) read
+ * any book in nanoseconds with zero IPC syscalls - no JSON scraping,
+ * no re-fetching.
+ *
+ * Layout (fixed, versioned):
+ *   ShmSegmentHeader                       magic/version/geometry
+ *   ShmBook[110]                           one per exchange, in enum order
+ * Each ShmBook is seqlock-protected: odd version = write in progress,
+ * readers retry until they copy a consistent even-versioned book.
+ *
+ * Timestamps are CLOCK_MONOTONIC-based (std::chrono::steady_clock),
+ * which is shared by all processes on the same host - readers compute
+ * book age against their own steady_clock.
+ */
+
+#pragma once
+
+#include "order_book_types.hpp"
+#include "order_book_cache.hpp"
+#include <atomic>
+#include <string>
+#include <cstring>
+#include <cstdio>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace sovereign {
+
+constexpr uint32_t SHM_BOOK_MAGIC = 0x534F5642;   // "SOVB"
+constexpr uint32_t SHM_BOOK_VERSION = 1;
+constexpr size_t SHM_BOOK_DEPTH = 50;
+constexpr const char* SHM_DEFAULT_NAME = "/sovereign_books";
+
+struct ShmLevel {
+    double price;
+    double volume;
+};
+
+struct ShmBook {
+    std::atomic<uint64_t> seqlock;  // Odd = writer in progress
+    uint64_t sequence;              // Cache sequence at publish time
+    int64_t timestamp_ns;           // steady_clock time of the book data
+    uint32_t bid_count;
+    uint32_t ask_count;
+    ShmLevel bids[SHM_BOOK_DEPTH];  // Price DESCENDING
+    ShmLevel asks[SHM_BOOK_DEPTH];  // Price ASCENDING
+};
+
+struct ShmSegmentHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t exchange_count;        // Exchange::COUNT at build time
+    uint32_t depth;                 // SHM_BOOK_DEPTH at build time
+    int64_t writer_pid;
+    uint8_t reserved[40];
+};
+
+struct ShmSegment {
+    ShmSegmentHeader header;
+    ShmBook books[static_cast<size_t>(Exchange::COUNT)];
+};
+
+static_assert(sizeof(ShmSegmentHeader) == 64, "Header must stay 64 bytes");
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "Seqlock must be address-free for cross-process use");
+
+// Owning copy a reader takes out of the segment
+struct ShmBookView {
+    uint64_t sequence;
+    int64_t timestamp_ns;
+    uint32_t bid_count;
+    uint32_t ask_count;
+    ShmLevel bids[SHM_BOOK_DEPTH];
+    ShmLevel asks[SHM_BOOK_DEPTH];
+
+    bool is_valid() const { return bid_count > 0 && ask_count > 0; }
+
+    int64_t age_ms() const {
+        auto now = std::chrono::steady_clock::now().time_since_epoch();
+        int64_t now_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+        return (now_ns - timestamp_ns) / 1000000;
+    }
+};
+
+// ============================================================================
+// WRITER (orderbook_service)
+// ============================================================================
+
+class ShmBookExporter {
+public:
+    ShmBookExporter() = default;
+    ~ShmBookExporter() { close(); }
+
+    ShmBookExporter(const ShmBookExporter&) = delete;
+    ShmBookExporter& operator=(const ShmBookExporter&) = delete;
+
+    /**
+     * Create (or take over) the named segment and initialize the header.
+     */
+    bool create(const std::string& name = SHM_DEFAULT_NAME) {
+        name_ = name;
+        int fd = shm_open(name.c_str(), O_CREAT | O_RDWR, 0644);
+        if (fd < 0) {
+            perror("[SHM] shm_open");
+            return false;
+        }
+        if (ftruncate(fd, sizeof(ShmSegment)) != 0) {
+            perror("[SHM] ftruncate");
+            ::close(fd);
+            return false;
+        }
+        void* addr = mmap(nullptr, sizeof(ShmSegment),
+                          PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (addr == MAP_FAILED) {
+            perror("[SHM] mmap");
+            return false;
+        }
+        segment_ = static_cast<ShmSegment*>(addr);
+
+        // Zero books, then publish the header last so a reader that
+        // validates the magic never sees uninitialized geometry
+        std::memset(segment_->books, 0, sizeof(segment_->books));
+        segment_->header.version = SHM_BOOK_VERSION;
+        segment_->header.exchange_count = static_cast<uint32_t>(Exchange::COUNT);
+        segment_->header.depth = SHM_BOOK_DEPTH;
+        segment_->header.writer_pid = getpid();
+        std::memset(segment_->header.reserved, 0, sizeof(segment_->header.reserved));
+        std::atomic_thread_fence(std::memory_order_release);
+        segment_->header.magic = SHM_BOOK_MAGIC;
+
+        printf("[SHM] Exporting %u books x %u levels to %s (%zu KB)\n",
+               segment_->header.exchange_count, segment_->header.depth,
+               name.c_str(), sizeof(ShmSegment) / 1024);
+        return true;
+    }
+
+    /**
+     * Publish every valid book from the cache. Each book is written
+     * under its own seqlock, so readers never block the writer.
+     *
+     * The segment keeps one slot per enum value (readers may come from a
+     * different build), but the scan only touches the active set.
+     */
+    void publish(const OrderBookCache& cache) {
+        if (!segment_) return;
+
+        for (Exchange ex : ENABLED_EXCHANGES) {
+            OrderBook book = cache.get(ex);
+            if (!book.is_valid()) continue;
+
+            ShmBook& slot = segment_->books[static_cast<size_t>(ex)];
+            if (slot.sequence == book.sequence) continue;  // Unchanged
+
+            slot.seqlock.fetch_add(1, std::memory_order_acq_rel);  // Now odd
+
+            slot.sequence = book.sequence;
+            slot.timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                book.timestamp.time_since_epoch()).count();
+            slot.bid_count = static_cast<uint32_t>(
+                std::min(book.bids.size(), SHM_BOOK_DEPTH));
+            slot.ask_count = static_cast<uint32_t>(
+                std::min(book.asks.size(), SHM_BOOK_DEPTH));
+            for (uint32_t j = 0; j < slot.bid_count; ++j) {
+                slot.bids[j] = {book.bids[j].price, book.bids[j].volume};
+            }
+            for (uint32_t j = 0; j < slot.ask_count; ++j) {
+                slot.asks[j] = {book.asks[j].price, book.asks[j].volume};
+            }
+
+            slot.seqlock.fetch_add(1, std::memory_order_release);  // Even again
+        }
+    }
+
+    /**
+     * Unmap and remove the segment (writer owns the name).
+     */
+    void close() {
+        if (segment_) {
+            munmap(segment_, sizeof(ShmSegment));
+            segment_ = nullptr;
+            shm_unlink(name_.c_str());
+        }
+    }
+
+private:
+    ShmSegment* segment_ = nullptr;
+    std::string name_;
+};
+
+// ============================================================================
+// READER (any co-located process)
+// ============================================================================
+
+class ShmBookReader {
+public:
+    ShmBookReader() = default;
+    ~ShmBookReader() { detach(); }
+
+    ShmBookReader(const ShmBookReader&) = delete;
+    ShmBookReader& operator=(const ShmBookReader&) = delete;
+
+    /**
+     * Attach read-only to an existing segment. Fails if the segment is
+     * missing or its version/geometry does not match this build.
+     */
+    bool attach(const std::string& name = SHM_DEFAULT_NAME) {
+        int fd = shm_open(name.c_str(), O_RDONLY, 0);
+        if (fd < 0) {
+            return false;
+        }
+        void* addr = mmap(nullptr, sizeof(ShmSegment), PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (addr == MAP_FAILED) {
+            return false;
+        }
+        segment_ = static_cast<const ShmSegment*>(addr);
+
+        const ShmSegmentHeader& h = segment_->header;
+        if (h.magic != SHM_BOOK_MAGIC || h.version != SHM_BOOK_VERSION ||
+            h.exchange_count != static_cast<uint32_t>(Exchange::COUNT) ||
+            h.depth != SHM_BOOK_DEPTH) {
+            detach();
+            return false;
+        }
+        return true;
+    }
+
+    bool attached() const { return segment_ != nullptr; }
+
+    /**
+     * Copy one book out under the seqlock. Returns false for an
+     * out-of-range exchange or a never-published slot.
+     */
+    bool read_book(Exchange exchange, ShmBookView& out) const {
+        size_t idx = static_cast<size_t>(exchange);
+        if (!segment_ || idx >= static_cast<size_t>(Exchange::COUNT)) {
+            return false;
+        }
+        const ShmBook& slot = segment_->books[idx];
+
+        for (;;) {
+            uint64_t v1 = slot.seqlock.load(std::memory_order_acquire);
+            if (v1 & 1) continue;  // Writer in progress
+
+            out.sequence = slot.sequence;
+            out.timestamp_ns = slot.timestamp_ns;
+            out.bid_count = std::min(slot.bid_count,
+                                     static_cast<uint32_t>(SHM_BOOK_DEPTH));
+            out.ask_count = std::min(slot.ask_count,
+                                     static_cast<uint32_t>(SHM_BOOK_DEPTH));
+            std::memcpy(out.bids, slot.bids, out.bid_count * sizeof(ShmLevel));
+            std::memcpy(out.asks, slot.asks, out.ask_count * sizeof(ShmLevel));
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            uint64_t v2 = slot.seqlock.load(std::memory_order_relaxed);
+            if (v1 == v2) break;  // Consistent copy
+        }
+        return out.sequence != 0 && out.is_valid();
+    }
+
+    void detach() {
+        if (segment_) {
+            munmap(const_cast<ShmSegment*>(segment_), sizeof(ShmSegment));
+            segment_ = nullptr;
+        }
+    }
+
+private:
+    const ShmSegment* segment_ = nullptr;
+};
+
+} // namespace sovereign
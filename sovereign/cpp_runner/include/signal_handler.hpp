@@ -19,8 +19,15 @@
 #include "order_book_types.hpp"
 #include "order_book_cache.hpp"
 #include "impact_calculator.hpp"
+#include "latency_histogram.hpp"
 #include <chrono>
 #include <cstdio>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <algorithm>
 
 namespace sovereign {
 
@@ -32,6 +39,14 @@ public:
     explicit SignalHandler(OrderBookCache& cache, TradingConfig config = {})
         : cache_(cache), config_(config) {}
 
+    ~SignalHandler() {
+        stop_workers();
+    }
+
+    // Pool threads hold `this` - no copies or moves
+    SignalHandler(const SignalHandler&) = delete;
+    SignalHandler& operator=(const SignalHandler&) = delete;
+
     /**
      * Process a blockchain signal and return trade decision.
      *
@@ -80,22 +95,29 @@ public:
         }
 
         // Get cached order book (sub-microsecond operation)
-        OrderBook book = cache_.get(exchange);
+        OrderBook book;
+        {
+            ScopedLatencyTimer timer(LatencyProbe::CACHE_READ);
+            book = cache_.get(exchange);
+        }
 
         // Calculate price impact based on direction
         double fees_pct = get_config(exchange).fee_pct * 100.0;  // Convert to %
         if (fees_pct < 0.01) fees_pct = config_.fees_pct;  // Use default if not set
 
-        if (signal.is_inflow) {
-            // INFLOW = deposit = seller will eat bids = SHORT signal
-            decision.impact = ImpactCalculator::calculate_sell_impact(
-                signal.btc_amount, book.bids);
-            decision.entry_price = book.best_bid();
-        } else {
-            // OUTFLOW = withdrawal = buyer will eat asks = LONG signal
-            decision.impact = ImpactCalculator::calculate_buy_impact(
-                signal.btc_amount, book.asks);
-            decision.entry_price = book.best_ask();
+        {
+            ScopedLatencyTimer timer(LatencyProbe::IMPACT_CALC);
+            if (signal.is_inflow) {
+                // INFLOW = deposit = seller will eat bids = SHORT signal
+                decision.impact = ImpactCalculator::calculate_sell_impact(
+                    signal.btc_amount, book.bids);
+                decision.entry_price = book.best_bid();
+            } else {
+                // OUTFLOW = withdrawal = buyer will eat asks = LONG signal
+                decision.impact = ImpactCalculator::calculate_buy_impact(
+                    signal.btc_amount, book.asks);
+                decision.entry_price = book.best_ask();
+            }
         }
 
         // Check if profitable (impact > 2x fees)
@@ -208,6 +230,92 @@ public:
         return cache_.is_valid(exchange) && !cache_.is_stale(exchange, config_.max_book_age_ms);
     }
 
+    // ========================================================================
+    // BATCH BEST-VENUE SELECTION
+    // ========================================================================
+
+    /**
+     * Evaluate one signal against EVERY fresh book and return the top-K
+     * tradeable venues ranked by leveraged expected return.
+     *
+     * A large deposit to Binance moves every venue - the most profitable
+     * book to trade against is often a thinner one elsewhere. This walks
+     * all exchanges through the lock-free snapshot path (no mutex, no
+     * allocation per venue) and ranks survivors by expected_return(),
+     * which already folds in per-exchange max leverage and fees.
+     *
+     * Snapshot depth (BookSnapshot::DEPTH levels) bounds the fill: a book
+     * that cannot absorb the amount in its top levels is skipped, which
+     * is conservative - such a venue would be the worst fill anyway.
+     *
+     * Venues are scanned by a worker pool when enable_parallel() was
+     * called (the calling thread always participates), serially
+     * otherwise. Serial over ~110 snapshots stays inside the 10us budget;
+     * the pool exists for configs that deepen the scan.
+     */
+    std::vector<TradeDecision> process_signal_all(const BlockchainSignal& signal,
+                                                  size_t top_k = 3) {
+        std::vector<TradeDecision> ranked;
+        if (signal.btc_amount < config_.min_deposit_btc || top_k == 0) {
+            return ranked;
+        }
+
+        constexpr size_t num_venues = ENABLED_EXCHANGE_COUNT;
+        batch_results_.resize(num_venues);
+
+        uint64_t gen;
+        {
+            std::lock_guard<std::mutex> lock(pool_mutex_);
+            gen = ++batch_generation_;
+            batch_signal_ = &signal;
+            batch_done_.store(0, std::memory_order_release);
+            // Cursor carries the generation in its upper half, so a worker
+            // waking up late can never claim a venue from the wrong batch
+            batch_cursor_.store(gen << 32, std::memory_order_release);
+        }
+        if (!workers_.empty()) {
+            pool_cv_.notify_all();
+        }
+
+        // The caller always scans too - in serial mode it does everything
+        scan_venues(gen, signal);
+        while (batch_done_.load(std::memory_order_acquire) < num_venues) {
+            std::this_thread::yield();
+        }
+
+        for (auto& decision : batch_results_) {
+            if (decision.should_trade) {
+                ranked.push_back(std::move(decision));
+            }
+        }
+
+        double fees = config_.fees_pct;
+        size_t keep = std::min(top_k, ranked.size());
+        std::partial_sort(ranked.begin(), ranked.begin() + keep, ranked.end(),
+                          [fees](const TradeDecision& a, const TradeDecision& b) {
+                              return a.expected_return(fees) > b.expected_return(fees);
+                          });
+        ranked.resize(keep);
+        return ranked;
+    }
+
+    /**
+     * Start a persistent worker pool for process_signal_all().
+     * Idempotent; workers sleep on a condition variable between batches.
+     */
+    void enable_parallel(size_t num_workers) {
+        if (!workers_.empty() || num_workers == 0) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(pool_mutex_);
+            pool_running_ = true;
+        }
+        for (size_t i = 0; i < num_workers; ++i) {
+            workers_.emplace_back([this]() { worker_loop(); });
+        }
+    }
+
     // ========================================================================
     // MULTI-INSTRUMENT DETERMINISTIC SIGNAL PROCESSING
     // ========================================================================
@@ -394,6 +502,136 @@ private:
     OrderBookCache& cache_;
     TradingConfig config_;
 
+    // ========================================================================
+    // BATCH SCAN MACHINERY
+    // ========================================================================
+
+    // Worker pool (empty = serial mode)
+    std::vector<std::thread> workers_;
+    std::mutex pool_mutex_;
+    std::condition_variable pool_cv_;
+    bool pool_running_ = false;
+
+    // Per-batch state. Cursor = (generation << 32) | next_venue_index;
+    // claims go through CAS so only workers on the current generation
+    // can take a slot or touch batch_results_.
+    uint64_t batch_generation_ = 0;            // Guarded by pool_mutex_
+    const BlockchainSignal* batch_signal_ = nullptr;
+    std::atomic<uint64_t> batch_cursor_{0};
+    std::atomic<size_t> batch_done_{0};
+    std::vector<TradeDecision> batch_results_;
+
+    void stop_workers() {
+        {
+            std::lock_guard<std::mutex> lock(pool_mutex_);
+            if (!pool_running_) return;
+            pool_running_ = false;
+        }
+        pool_cv_.notify_all();
+        for (auto& w : workers_) {
+            w.join();
+        }
+        workers_.clear();
+    }
+
+    void worker_loop() {
+        uint64_t seen = 0;
+        for (;;) {
+            uint64_t gen;
+            const BlockchainSignal* signal;
+            {
+                std::unique_lock<std::mutex> lock(pool_mutex_);
+                pool_cv_.wait(lock, [&]() {
+                    return !pool_running_ || batch_generation_ != seen;
+                });
+                if (!pool_running_) return;
+                seen = gen = batch_generation_;
+                signal = batch_signal_;
+            }
+            scan_venues(gen, *signal);
+        }
+    }
+
+    // Claim venues off the shared cursor until the batch is exhausted
+    // or a newer batch has replaced it
+    void scan_venues(uint64_t gen, const BlockchainSignal& signal) {
+        constexpr size_t num_venues = ENABLED_EXCHANGE_COUNT;
+        uint64_t cur = batch_cursor_.load(std::memory_order_acquire);
+        for (;;) {
+            if ((cur >> 32) != gen) return;  // Stale batch - stand down
+            size_t idx = static_cast<size_t>(cur & 0xFFFFFFFFu);
+            if (idx >= num_venues) return;
+            if (!batch_cursor_.compare_exchange_weak(cur, cur + 1,
+                                                     std::memory_order_acq_rel)) {
+                continue;  // Lost the claim - cur was reloaded
+            }
+            batch_results_[idx] = evaluate_venue(ENABLED_EXCHANGES[idx], signal);
+            batch_done_.fetch_add(1, std::memory_order_release);
+            cur = batch_cursor_.load(std::memory_order_acquire);
+        }
+    }
+
+    /**
+     * Score one venue against the signal using only its lock-free
+     * snapshot - no mutex, no book copy. Skip reasons stay within SSO
+     * so a full scan does not allocate for the ~100 losing venues.
+     */
+    TradeDecision evaluate_venue(Exchange exchange, const BlockchainSignal& signal) {
+        auto start = std::chrono::high_resolution_clock::now();
+        TradeDecision decision{};
+        decision.is_short = signal.is_inflow;
+        decision.exchange = exchange;
+
+        BookSnapshot snap;
+        if (!cache_.read_snapshot(exchange, snap)) {
+            decision.reason = "No snapshot";
+            record_timing(decision, start);
+            return decision;
+        }
+        if (snap.age_ms() > config_.max_book_age_ms) {
+            decision.reason = "Stale book";
+            record_timing(decision, start);
+            return decision;
+        }
+
+        double fees_pct = get_exchange_config(exchange).fee_pct * 100.0;
+        if (fees_pct < 0.01) fees_pct = config_.fees_pct;
+
+        if (signal.is_inflow) {
+            decision.impact = ImpactCalculator::calculate_sell_impact(
+                signal.btc_amount, snap.bids, snap.bid_count);
+            decision.entry_price = snap.best_bid();
+        } else {
+            decision.impact = ImpactCalculator::calculate_buy_impact(
+                signal.btc_amount, snap.asks, snap.ask_count);
+            decision.entry_price = snap.best_ask();
+        }
+
+        double min_required = fees_pct * config_.min_impact_multiple;
+        if (std::abs(decision.impact.price_drop_pct) < min_required) {
+            decision.reason = "Impact < fees";
+            record_timing(decision, start);
+            return decision;
+        }
+
+        // Snapshot depth bounds the fill - unfillable here means the
+        // venue is too thin to matter
+        if (decision.impact.volume_remaining > 0.0) {
+            decision.reason = "Thin book";
+            record_timing(decision, start);
+            return decision;
+        }
+
+        decision.exit_price = ImpactCalculator::calculate_exit_price(
+            decision.entry_price, decision.impact, decision.is_short,
+            config_.take_profit_ratio);
+        decision.should_trade = true;
+        decision.reason = "Ranked";
+
+        record_timing(decision, start);
+        return decision;
+    }
+
     void record_timing(TradeDecision& decision,
                        std::chrono::high_resolution_clock::time_point start) {
         auto end = std::chrono::high_resolution_clock::now();
@@ -0,0 +1,249 @@
+#pragma once
+//! TRANSACTION PIPELINE - PARALLEL DECODE, ORDERED APPLY
+//!
+//! The single-threaded main loop serialized zmq_msg_recv, full decode
+//! (SHA256 + address extraction + N mmap lookups) and console I/O, so
+//! post-block mempool floods backed the ZMQ queue up and signals
+//! arrived hundreds of ms late. This splits the work into stages:
+//!
+//!   receive thread --round robin--> [SPSC ring] -> decode worker 0
+//!                                   [SPSC ring] -> decode worker 1 ...
+//!   decode workers ---------------> [SPSC ring per worker]
+//!   apply thread (round robin pop, preserves arrival order)
+//!       -> FlowDetector::process_prepared (UTXO state, single thread)
+//!       -> [SPSC ring] -> output thread (console I/O)
+//!
+//! Round-robin dispatch and round-robin collection keep transactions
+//! in arrival order without a reorder buffer, which matters because a
+//! child tx can spend a parent that arrived microseconds earlier.
+
+#include "flow_detector.hpp"
+#include "cpu_affinity.hpp"
+#include <array>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <functional>
+#include <optional>
+#include <memory>
+#include <cstdint>
+
+// Lock-free single-producer single-consumer ring. Capacity must be a
+// power of two; one slot is sacrificed to distinguish full from empty.
+template <typename T, size_t CAPACITY>
+class SpscRing {
+    static_assert((CAPACITY & (CAPACITY - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    bool try_push(T&& item) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        size_t next = (tail + 1) & (CAPACITY - 1);
+        if (next == head_.load(std::memory_order_acquire)) {
+            return false;  // Full
+        }
+        slots_[tail] = std::move(item);
+        tail_.store(next, std::memory_order_release);
+        return true;
+    }
+
+    bool try_pop(T& out) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) {
+            return false;  // Empty
+        }
+        out = std::move(slots_[head]);
+        head_.store((head + 1) & (CAPACITY - 1), std::memory_order_release);
+        return true;
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+private:
+    std::array<T, CAPACITY> slots_;
+    alignas(64) std::atomic<size_t> head_{0};  // Consumer cursor
+    alignas(64) std::atomic<size_t> tail_{0};  // Producer cursor
+};
+
+class TxPipeline {
+public:
+    static constexpr size_t RING_CAPACITY = 4096;
+    static constexpr size_t MAX_WORKERS = 8;
+
+    TxPipeline(std::shared_ptr<MmapAddressDatabase> addresses,
+               FlowDetector& detector,
+               std::function<void(const FlowResult&)> emit,
+               size_t num_workers)
+        : addresses_(std::move(addresses))
+        , detector_(detector)
+        , emit_(std::move(emit))
+        , num_workers_(num_workers == 0 ? 1 : (num_workers > MAX_WORKERS ? MAX_WORKERS : num_workers)) {
+        for (size_t i = 0; i < num_workers_; ++i) {
+            in_rings_.push_back(std::make_unique<InRing>());
+            out_rings_.push_back(std::make_unique<OutRing>());
+        }
+        for (auto& c : submitted_) c.store(0, std::memory_order_relaxed);
+        for (auto& c : collected_) c.store(0, std::memory_order_relaxed);
+
+        running_.store(true, std::memory_order_release);
+        for (size_t i = 0; i < num_workers_; ++i) {
+            workers_.emplace_back([this, i] { worker_loop(i); });
+        }
+        apply_thread_ = std::thread([this] { apply_loop(); });
+        output_thread_ = std::thread([this] { output_loop(); });
+    }
+
+    ~TxPipeline() { stop(); }
+
+    TxPipeline(const TxPipeline&) = delete;
+    TxPipeline& operator=(const TxPipeline&) = delete;
+
+    // Called from the receive thread only. Copies the raw tx into the
+    // next worker's ring; spins briefly under backpressure, then drops
+    // (and counts) rather than stalling the ZMQ socket forever. The
+    // worker cursor only advances on a successful push - a drop must
+    // not consume the slot, or the apply thread's round-robin would be
+    // skewed one position on that worker for every tx that follows.
+    bool submit(const uint8_t* data, size_t len) {
+        size_t worker = next_worker_;
+
+        std::vector<uint8_t> buf(data, data + len);
+        for (int spin = 0; spin < 1000; ++spin) {
+            if (in_rings_[worker]->try_push(std::move(buf))) {
+                submitted_[worker].fetch_add(1, std::memory_order_release);
+                next_worker_ = (worker + 1) % num_workers_;
+                return true;
+            }
+            if (!running_.load(std::memory_order_acquire)) return false;
+            std::this_thread::yield();
+        }
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    void stop() {
+        if (!running_.exchange(false)) return;
+        for (auto& w : workers_) w.join();
+        apply_thread_.join();
+        output_thread_.join();
+    }
+
+    [[nodiscard]] uint64_t dropped() const noexcept {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+private:
+    void worker_loop(size_t idx) {
+        sovereign::ThreadTopology::instance().pin_current(
+            sovereign::ThreadRole::DECODE);
+
+        std::vector<uint8_t> raw;
+        while (true) {
+            if (!in_rings_[idx]->try_pop(raw)) {
+                if (!running_.load(std::memory_order_acquire) && in_rings_[idx]->empty()) {
+                    return;
+                }
+                std::this_thread::yield();
+                continue;
+            }
+
+            // Push even on decode failure so the apply thread's
+            // round-robin stays aligned with the dispatch order
+            auto prep = FlowDetector::prepare_raw_tx(*addresses_, raw.data(), raw.size());
+            while (!out_rings_[idx]->try_push(std::move(prep))) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void apply_loop() {
+        // The apply stage runs flow detection - this is the
+        // signal-critical thread the config isolates from pollers
+        sovereign::ThreadTopology::instance().pin_current(
+            sovereign::ThreadRole::SIGNAL);
+
+        size_t cur = 0;
+        std::optional<PreparedTx> prep;
+        while (true) {
+            if (!out_rings_[cur]->try_pop(prep)) {
+                bool worker_done = !running_.load(std::memory_order_acquire) &&
+                    collected_[cur].load(std::memory_order_relaxed) ==
+                        submitted_[cur].load(std::memory_order_acquire);
+                if (worker_done) {
+                    if (all_collected()) {
+                        // Release-publish after the final result push so
+                        // output_loop cannot observe the flag early
+                        apply_done_.store(true, std::memory_order_release);
+                        return;
+                    }
+                    cur = (cur + 1) % num_workers_;
+                }
+                std::this_thread::yield();
+                continue;
+            }
+            collected_[cur].fetch_add(1, std::memory_order_relaxed);
+            cur = (cur + 1) % num_workers_;
+
+            if (!prep) continue;
+            auto flow = detector_.process_prepared(*prep);
+            if (flow) {
+                while (!result_ring_.try_push(std::move(*flow))) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+    }
+
+    // Exit is gated on apply_done_, not on all_collected(): the apply
+    // thread counts a tx as collected before its FlowResult lands in
+    // the ring, so "ring empty && all collected" can hold while the
+    // last result is still in flight and would drop it at shutdown.
+    void output_loop() {
+        FlowResult result;
+        while (true) {
+            if (!result_ring_.try_pop(result)) {
+                if (apply_done_.load(std::memory_order_acquire) &&
+                    result_ring_.empty()) {
+                    return;
+                }
+                std::this_thread::yield();
+                continue;
+            }
+            emit_(result);
+        }
+    }
+
+    [[nodiscard]] bool all_collected() const noexcept {
+        for (size_t i = 0; i < num_workers_; ++i) {
+            if (collected_[i].load(std::memory_order_relaxed) !=
+                submitted_[i].load(std::memory_order_acquire)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::shared_ptr<MmapAddressDatabase> addresses_;
+    FlowDetector& detector_;
+    std::function<void(const FlowResult&)> emit_;
+    size_t num_workers_;
+    size_t next_worker_ = 0;
+
+    // unique_ptr keeps the large rings off the stack and stable in memory
+    struct InRing : SpscRing<std::vector<uint8_t>, RING_CAPACITY> {};
+    struct OutRing : SpscRing<std::optional<PreparedTx>, RING_CAPACITY> {};
+    std::vector<std::unique_ptr<InRing>> in_rings_;
+    std::vector<std::unique_ptr<OutRing>> out_rings_;
+    SpscRing<FlowResult, RING_CAPACITY> result_ring_;
+
+    std::array<std::atomic<uint64_t>, MAX_WORKERS> submitted_{};
+    std::array<std::atomic<uint64_t>, MAX_WORKERS> collected_{};
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<bool> running_{false};
+    std::atomic<bool> apply_done_{false};  // Set once apply_loop has drained
+
+    std::vector<std::thread> workers_;
+    std::thread apply_thread_;
+    std::thread output_thread_;
+};
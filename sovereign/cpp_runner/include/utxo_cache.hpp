@@ -1,9 +1,25 @@
 #pragma once
 
+#include "utxo_journal.hpp"
 #include <string>
+#include <array>
+#include <vector>
 #include <unordered_map>
 #include <optional>
+#include <memory>
 #include <cstdint>
+#include <cstring>
+
+// Snapshot file format (like addresses.bin - load is one read, no SQL):
+// Header (64 bytes):
+//   [magic:4][version:4][utxo_count:8][string_count:4][reserved:44]
+// String table:
+//   [len:2][bytes] x string_count (interned exchange names + addresses)
+// Entries:
+//   [txid:32][vout:4][value:8][exchange_id:4][address_id:4] x utxo_count
+
+constexpr uint32_t UTXO_SNAP_MAGIC = 0x4F585455;  // "UTXO"
+constexpr uint32_t UTXO_SNAP_VERSION = 1;
 
 struct UtxoInfo {
     uint64_t value_sat;
@@ -11,17 +27,34 @@ struct UtxoInfo {
     std::string address;
 };
 
+// Allocation-free spend result: the strings point into the cache's
+// intern table, which never shrinks, so they stay valid for the
+// lifetime of the cache.
+struct UtxoView {
+    uint64_t value_sat;
+    const std::string* exchange;
+    const std::string* address;
+};
+
+// Raw 32-byte txid + vout. Keying on binary instead of the 64-char hex
+// string saves one heap allocation per entry and makes equality a
+// memcmp instead of a string compare.
+struct OutpointKey {
+    std::array<uint8_t, 32> txid;
+    uint32_t vout;
+
+    bool operator==(const OutpointKey& o) const noexcept {
+        return vout == o.vout && std::memcmp(txid.data(), o.txid.data(), 32) == 0;
+    }
+};
+
 struct OutpointHash {
-    size_t operator()(const std::pair<std::string, uint32_t>& p) const noexcept {
-        // FNV-1a hash combining txid and vout
-        size_t hash = 14695981039346656037ULL;
-        for (char c : p.first) {
-            hash ^= static_cast<size_t>(c);
-            hash *= 1099511628211ULL;
-        }
-        hash ^= static_cast<size_t>(p.second);
-        hash *= 1099511628211ULL;
-        return hash;
+    size_t operator()(const OutpointKey& k) const noexcept {
+        // txid is already a double-SHA256, so its first 8 bytes are
+        // uniformly distributed - no need to re-hash, just fold in vout
+        uint64_t h;
+        std::memcpy(&h, k.txid.data(), sizeof(h));
+        return h ^ (static_cast<uint64_t>(k.vout) * 0x9E3779B97F4A7C15ULL);
     }
 };
 
@@ -32,26 +65,111 @@ public:
     // Load existing UTXOs from SQLite
     bool load(const std::string& db_path);
 
-    // Add new UTXO (output to exchange)
+    // Snapshot + journal persistence (instant restart path)
+    bool load_snapshot(const std::string& path);
+    bool save_snapshot(const std::string& path) const;
+    bool replay_journal(const std::string& path);
+
+    // All adds/spends after this call are recorded to the journal
+    void set_journal(std::shared_ptr<UtxoJournal> journal) {
+        journal_ = std::move(journal);
+    }
+
+    // Add new UTXO (output to exchange) - binary txid
+    inline void add(const uint8_t* txid, uint32_t vout,
+                    uint64_t value_sat, const std::string& exchange,
+                    const std::string& address) {
+        OutpointKey key;
+        std::memcpy(key.txid.data(), txid, 32);
+        key.vout = vout;
+        cache_[key] = {value_sat, intern(exchange), intern(address)};
+        if (journal_) journal_->record_add(txid, vout, value_sat, exchange, address);
+    }
+
+    // Add new UTXO - hex txid convenience wrapper
     inline void add(const std::string& txid, uint32_t vout,
-                   uint64_t value_sat, const std::string& exchange,
-                   const std::string& address) {
-        cache_[{txid, vout}] = {value_sat, exchange, address};
+                    uint64_t value_sat, const std::string& exchange,
+                    const std::string& address) {
+        std::array<uint8_t, 32> raw;
+        if (!parse_txid_hex(txid, raw)) return;
+        add(raw.data(), vout, value_sat, exchange, address);
+    }
+
+    // Spend UTXO (input from exchange) - binary txid, single hash
+    // probe, zero allocations (strings are interned views)
+    [[nodiscard]] std::optional<UtxoView> spend_view(const uint8_t* txid, uint32_t vout) {
+        OutpointKey key;
+        std::memcpy(key.txid.data(), txid, 32);
+        key.vout = vout;
+        auto it = cache_.find(key);
+        if (it == cache_.end()) return std::nullopt;
+        UtxoValue v = it->second;
+        cache_.erase(it);
+        if (journal_) journal_->record_spend(txid, vout);
+        return UtxoView{v.value_sat, interned_[v.exchange_id], interned_[v.address_id]};
+    }
+
+    // Spend UTXO - hex txid
+    [[nodiscard]] std::optional<UtxoView> spend_view(const std::string& txid, uint32_t vout) {
+        std::array<uint8_t, 32> raw;
+        if (!parse_txid_hex(txid, raw)) return std::nullopt;
+        return spend_view(raw.data(), vout);
+    }
+
+    // Owning-copy wrappers for callers that outlive the cache
+    [[nodiscard]] std::optional<UtxoInfo> spend(const uint8_t* txid, uint32_t vout) {
+        auto view = spend_view(txid, vout);
+        if (!view) return std::nullopt;
+        return UtxoInfo{view->value_sat, *view->exchange, *view->address};
     }
 
-    // Spend UTXO (input from exchange)
     [[nodiscard]] std::optional<UtxoInfo> spend(const std::string& txid, uint32_t vout) {
-        auto it = cache_.find({txid, vout});
-        if (it != cache_.end()) {
-            UtxoInfo info = std::move(it->second);
-            cache_.erase(it);
-            return info;
-        }
-        return std::nullopt;
+        auto view = spend_view(txid, vout);
+        if (!view) return std::nullopt;
+        return UtxoInfo{view->value_sat, *view->exchange, *view->address};
     }
 
     [[nodiscard]] size_t size() const noexcept { return cache_.size(); }
 
 private:
-    std::unordered_map<std::pair<std::string, uint32_t>, UtxoInfo, OutpointHash> cache_;
+    // 16 bytes vs three heap strings per entry. Exchange names and
+    // deposit addresses repeat heavily, so both go through the intern
+    // table and entries only carry indices.
+    struct UtxoValue {
+        uint64_t value_sat;
+        uint32_t exchange_id;
+        uint32_t address_id;
+    };
+
+    static bool parse_txid_hex(const std::string& hex, std::array<uint8_t, 32>& out) noexcept {
+        if (hex.size() != 64) return false;
+        for (size_t i = 0; i < 32; ++i) {
+            int hi = hex_nibble(hex[i * 2]);
+            int lo = hex_nibble(hex[i * 2 + 1]);
+            if (hi < 0 || lo < 0) return false;
+            out[i] = static_cast<uint8_t>((hi << 4) | lo);
+        }
+        return true;
+    }
+
+    static int hex_nibble(char c) noexcept {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    }
+
+    uint32_t intern(const std::string& s) {
+        auto it = intern_ids_.find(s);
+        if (it != intern_ids_.end()) return it->second;
+        uint32_t id = static_cast<uint32_t>(interned_.size());
+        auto [pos, _] = intern_ids_.emplace(s, id);
+        interned_.push_back(&pos->first);  // map keys are pointer-stable
+        return id;
+    }
+
+    std::unordered_map<OutpointKey, UtxoValue, OutpointHash> cache_;
+    std::unordered_map<std::string, uint32_t> intern_ids_;
+    std::vector<const std::string*> interned_;
+    std::shared_ptr<UtxoJournal> journal_;
 };
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+// Append-only journal of UTXO adds/spends. Records are staged in an
+// in-memory buffer on the hot path (one short mutex hold, no I/O) and
+// flushed to disk by a background thread, so a crash loses at most the
+// last flush interval instead of everything since the last SQLite
+// export.
+//
+// Record formats:
+//   ADD:   [type:1][txid:32][vout:4][value:8][ex_len:2][ex][addr_len:2][addr]
+//   SPEND: [type:1][txid:32][vout:4]
+//
+// A truncated trailing record (crash mid-write) is detected and
+// dropped on replay.
+
+class UtxoJournal {
+public:
+    static constexpr uint8_t REC_ADD = 1;
+    static constexpr uint8_t REC_SPEND = 2;
+    static constexpr size_t FLUSH_THRESHOLD = 1 << 20;  // force flush at 1 MB
+
+    UtxoJournal() = default;
+    ~UtxoJournal() { close(); }
+
+    UtxoJournal(const UtxoJournal&) = delete;
+    UtxoJournal& operator=(const UtxoJournal&) = delete;
+
+    // Open for append and start the flush thread. truncate discards
+    // existing records (after they have been folded into a snapshot).
+    bool open(const std::string& path, bool truncate) {
+        int flags = O_WRONLY | O_CREAT | O_APPEND;
+        if (truncate) flags |= O_TRUNC;
+        fd_ = ::open(path.c_str(), flags, 0644);
+        if (fd_ < 0) return false;
+
+        running_ = true;
+        flusher_ = std::thread([this] { flush_loop(); });
+        return true;
+    }
+
+    void close() {
+        if (running_) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                running_ = false;
+            }
+            cv_.notify_all();
+            flusher_.join();
+        }
+        if (fd_ >= 0) {
+            flush_buffer();
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    void record_add(const uint8_t* txid, uint32_t vout, uint64_t value_sat,
+                    const std::string& exchange, const std::string& address) {
+        uint8_t rec[1 + 32 + 4 + 8 + 2];
+        rec[0] = REC_ADD;
+        std::memcpy(rec + 1, txid, 32);
+        std::memcpy(rec + 33, &vout, 4);
+        std::memcpy(rec + 37, &value_sat, 8);
+        uint16_t ex_len = static_cast<uint16_t>(exchange.size());
+        std::memcpy(rec + 45, &ex_len, 2);
+        uint16_t addr_len = static_cast<uint16_t>(address.size());
+
+        bool wake;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            buffer_.insert(buffer_.end(), rec, rec + sizeof(rec));
+            buffer_.insert(buffer_.end(), exchange.begin(), exchange.end());
+            const uint8_t* lp = reinterpret_cast<const uint8_t*>(&addr_len);
+            buffer_.insert(buffer_.end(), lp, lp + 2);
+            buffer_.insert(buffer_.end(), address.begin(), address.end());
+            wake = buffer_.size() >= FLUSH_THRESHOLD;
+        }
+        if (wake) cv_.notify_one();
+    }
+
+    void record_spend(const uint8_t* txid, uint32_t vout) {
+        uint8_t rec[1 + 32 + 4];
+        rec[0] = REC_SPEND;
+        std::memcpy(rec + 1, txid, 32);
+        std::memcpy(rec + 33, &vout, 4);
+
+        bool wake;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            buffer_.insert(buffer_.end(), rec, rec + sizeof(rec));
+            wake = buffer_.size() >= FLUSH_THRESHOLD;
+        }
+        if (wake) cv_.notify_one();
+    }
+
+private:
+    void flush_loop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (running_) {
+            cv_.wait_for(lock, std::chrono::milliseconds(100));
+            if (buffer_.empty()) continue;
+            pending_.swap(buffer_);
+            lock.unlock();
+            write_pending();
+            lock.lock();
+        }
+    }
+
+    // Drain anything staged but not yet written (called with the flush
+    // thread stopped)
+    void flush_buffer() {
+        pending_.swap(buffer_);
+        write_pending();
+    }
+
+    void write_pending() {
+        const uint8_t* p = pending_.data();
+        size_t remaining = pending_.size();
+        while (remaining > 0) {
+            ssize_t n = ::write(fd_, p, remaining);
+            if (n <= 0) break;
+            p += n;
+            remaining -= static_cast<size_t>(n);
+        }
+        pending_.clear();
+    }
+
+    int fd_ = -1;
+    std::vector<uint8_t> buffer_;
+    std::vector<uint8_t> pending_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::thread flusher_;
+    bool running_ = false;
+};
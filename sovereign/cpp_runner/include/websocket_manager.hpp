@@ -3,16 +3,24 @@
  *
  * PURE DATA. NO MOCK. MATH NEVER LIES.
  *
- * This manages WebSocket connections to multiple exchanges for
- * real-time order book updates. Pre-caches books for sub-millisecond
- * lookups when blockchain signals arrive.
+ * Streaming engine multiplexing every WebSocket-capable exchange over a
+ * small number of event loops (default 2). Exchanges are sharded across
+ * loops by index, so one slow TLS handshake never stalls the rest of
+ * the fleet. Per-exchange parsing is dispatched through a handler table
+ * built from the exchange_handlers/ headers - adding an exchange means
+ * writing a handler and one registration line, not editing switches.
  *
- * Supported exchanges (with WebSocket):
+ * Registered handlers:
  * - Gemini: wss://api.gemini.com/v1/marketdata/btcusd
  * - Deribit: wss://www.deribit.com/ws/api/v2
  * - Poloniex: wss://ws.poloniex.com/ws/public
  * - MEXC: wss://wbs.mexc.com/ws
  *
+ * Reconnects automatically and fires a re-sync callback on each
+ * (re)connect so the owner can seed the book from REST before deltas
+ * resume. Counters track messages, parse failures and reconnects per
+ * exchange for backpressure monitoring.
+ *
  * Uses libwebsockets for connection management.
  */
 
@@ -20,11 +28,17 @@
 
 #include "order_book_types.hpp"
 #include "order_book_cache.hpp"
+#include "exchange_handlers/gemini.hpp"
+#include "exchange_handlers/deribit.hpp"
+#include "exchange_handlers/poloniex.hpp"
+#include "exchange_handlers/mexc.hpp"
+#include "latency_histogram.hpp"
+#include "level_pool.hpp"
+#include "cpu_affinity.hpp"
 #include <libwebsockets.h>
 #include <thread>
 #include <atomic>
 #include <array>
-#include <mutex>
 #include <string>
 #include <vector>
 #include <functional>
@@ -33,8 +47,58 @@
 
 namespace sovereign {
 
-// Forward declaration
-class ExchangeHandler;
+// ============================================================================
+// HANDLER DISPATCH TABLE
+// ============================================================================
+// One entry per exchange, populated from the exchange_handlers/ classes.
+// An exchange streams if and only if it has a ws_url AND a registered
+// handler - a URL without a parser would just burn a connection.
+// ============================================================================
+
+struct WsHandler {
+    bool available = false;
+    std::string (*subscribe)() = nullptr;
+    bool (*parse)(const std::string&, OrderBook&) = nullptr;
+};
+
+inline const std::array<WsHandler, ENABLED_EXCHANGE_COUNT>&
+ws_handler_table() {
+    static const auto table = []() {
+        std::array<WsHandler, ENABLED_EXCHANGE_COUNT> t{};
+        auto reg = [&t](Exchange ex, std::string (*sub)(),
+                        bool (*parse)(const std::string&, OrderBook&)) {
+            auto& h = t[exchange_slot(ex)];
+            h.available = true;
+            h.subscribe = sub;
+            h.parse = parse;
+        };
+        // Each registration is guarded with if constexpr, so a subset
+        // build never references a disabled handler and the linker can
+        // discard its parsing code entirely.
+        if constexpr (exchange_enabled(Exchange::GEMINI)) {
+            reg(Exchange::GEMINI,
+                &exchange::GeminiHandler::get_subscribe_message,
+                &exchange::GeminiHandler::parse_ws_message);
+        }
+        if constexpr (exchange_enabled(Exchange::DERIBIT)) {
+            reg(Exchange::DERIBIT,
+                &exchange::DeribitHandler::get_subscribe_message,
+                &exchange::DeribitHandler::parse_ws_message);
+        }
+        if constexpr (exchange_enabled(Exchange::POLONIEX)) {
+            reg(Exchange::POLONIEX,
+                &exchange::PoloniexHandler::get_subscribe_message,
+                &exchange::PoloniexHandler::parse_ws_message);
+        }
+        if constexpr (exchange_enabled(Exchange::MEXC)) {
+            reg(Exchange::MEXC,
+                &exchange::MexcHandler::get_subscribe_message,
+                &exchange::MexcHandler::parse_ws_message);
+        }
+        return t;
+    }();
+    return table;
+}
 
 /**
  * WebSocket Manager - manages connections to all WebSocket-enabled exchanges.
@@ -44,10 +108,14 @@ public:
     // Callback for connection status changes
     using StatusCallback = std::function<void(Exchange, bool connected)>;
 
+    // Fired on every (re)connect so the owner can REST-fetch a fresh
+    // snapshot before incremental updates resume
+    using ResyncCallback = std::function<void(Exchange)>;
+
     explicit WebSocketManager(OrderBookCache& cache)
         : cache_(cache) {
         // Initialize connection states
-        for (size_t i = 0; i < static_cast<size_t>(Exchange::COUNT); ++i) {
+        for (size_t i = 0; i < ENABLED_EXCHANGE_COUNT; ++i) {
             connection_states_[i].store(false);
         }
     }
@@ -61,14 +129,20 @@ public:
     WebSocketManager& operator=(const WebSocketManager&) = delete;
 
     /**
-     * Start WebSocket connections to all exchanges.
+     * Start WebSocket connections to all exchanges with handlers.
+     * Exchanges are sharded across num_loops service threads.
      */
-    void start() {
+    void start(size_t num_loops = 2) {
         if (running_.load()) return;
         running_.store(true);
 
-        // Start event loop thread
-        event_thread_ = std::thread(&WebSocketManager::event_loop, this);
+        if (num_loops == 0) num_loops = 1;
+        if (num_loops > MAX_LOOPS) num_loops = MAX_LOOPS;
+        num_loops_ = num_loops;
+
+        for (size_t loop = 0; loop < num_loops_; ++loop) {
+            event_threads_.emplace_back(&WebSocketManager::event_loop, this, loop);
+        }
     }
 
     /**
@@ -76,17 +150,20 @@ public:
      */
     void stop() {
         running_.store(false);
-        if (event_thread_.joinable()) {
-            event_thread_.join();
+        for (auto& t : event_threads_) {
+            if (t.joinable()) {
+                t.join();
+            }
         }
+        event_threads_.clear();
     }
 
     /**
      * Check if a specific exchange is connected.
      */
     bool is_connected(Exchange exchange) const {
-        size_t idx = static_cast<size_t>(exchange);
-        if (idx >= static_cast<size_t>(Exchange::COUNT)) return false;
+        size_t idx = exchange_slot(exchange);
+        if (idx >= ENABLED_EXCHANGE_COUNT) return false;
         return connection_states_[idx].load();
     }
 
@@ -95,9 +172,9 @@ public:
      */
     int connected_count() const {
         int count = 0;
-        for (size_t i = 0; i < static_cast<size_t>(Exchange::COUNT); ++i) {
+        for (size_t i = 0; i < ENABLED_EXCHANGE_COUNT; ++i) {
             if (connection_states_[i].load()) {
-                const auto config = get_exchange_config(static_cast<Exchange>(i));
+                const auto& config = get_exchange_config(ENABLED_EXCHANGES[i]);
                 if (config.has_websocket) {
                     ++count;
                 }
@@ -111,8 +188,8 @@ public:
      */
     static int websocket_exchange_count() {
         int count = 0;
-        for (size_t i = 0; i < static_cast<size_t>(Exchange::COUNT); ++i) {
-            auto config = get_exchange_config(static_cast<Exchange>(i));
+        for (size_t i = 0; i < ENABLED_EXCHANGE_COUNT; ++i) {
+            const auto& config = get_exchange_config(ENABLED_EXCHANGES[i]);
             if (config.has_websocket) {
                 ++count;
             }
@@ -120,6 +197,21 @@ public:
         return count;
     }
 
+    /**
+     * Count of exchanges that can actually stream (URL + parser).
+     */
+    static int streamable_exchange_count() {
+        int count = 0;
+        const auto& handlers = ws_handler_table();
+        for (size_t i = 0; i < ENABLED_EXCHANGE_COUNT; ++i) {
+            const auto& config = get_exchange_config(ENABLED_EXCHANGES[i]);
+            if (config.has_websocket && handlers[i].available) {
+                ++count;
+            }
+        }
+        return count;
+    }
+
     /**
      * Set callback for connection status changes.
      */
@@ -127,12 +219,19 @@ public:
         status_callback_ = std::move(callback);
     }
 
+    /**
+     * Set callback for snapshot re-sync on (re)connect.
+     */
+    void set_resync_callback(ResyncCallback callback) {
+        resync_callback_ = std::move(callback);
+    }
+
     /**
      * Get last message time for an exchange.
      */
     int64_t last_message_age_ms(Exchange exchange) const {
-        size_t idx = static_cast<size_t>(exchange);
-        if (idx >= static_cast<size_t>(Exchange::COUNT)) return -1;
+        size_t idx = exchange_slot(exchange);
+        if (idx >= ENABLED_EXCHANGE_COUNT) return -1;
 
         auto now = std::chrono::steady_clock::now();
         auto age = std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -140,40 +239,99 @@ public:
         return age;
     }
 
+    // ========================================================================
+    // BACKPRESSURE / HEALTH COUNTERS
+    // ========================================================================
+
+    uint64_t message_count(Exchange exchange) const {
+        size_t idx = exchange_slot(exchange);
+        return idx < ENABLED_EXCHANGE_COUNT ? message_counts_[idx].load() : 0;
+    }
+
+    uint64_t parse_failure_count(Exchange exchange) const {
+        size_t idx = exchange_slot(exchange);
+        return idx < ENABLED_EXCHANGE_COUNT ? parse_failures_[idx].load() : 0;
+    }
+
+    uint64_t reconnect_count(Exchange exchange) const {
+        size_t idx = exchange_slot(exchange);
+        return idx < ENABLED_EXCHANGE_COUNT ? reconnect_counts_[idx].load() : 0;
+    }
+
+    /**
+     * Print per-exchange streaming health (for monitoring).
+     */
+    void print_status() const {
+        printf("[WS] %d/%d streamable exchanges connected\n",
+               connected_count(), streamable_exchange_count());
+        const auto& handlers = ws_handler_table();
+        for (size_t i = 0; i < ENABLED_EXCHANGE_COUNT; ++i) {
+            if (!handlers[i].available) continue;
+            Exchange ex = ENABLED_EXCHANGES[i];
+            printf("  %s: %s | msgs=%lu | parse_fail=%lu | reconnects=%lu | last=%ldms\n",
+                   exchange_name(ex),
+                   connection_states_[i].load() ? "UP" : "DOWN",
+                   message_counts_[i].load(),
+                   parse_failures_[i].load(),
+                   reconnect_counts_[i].load(),
+                   last_message_age_ms(ex));
+        }
+    }
+
 private:
+    static constexpr size_t MAX_LOOPS = 4;
+
     OrderBookCache& cache_;
 
-    // libwebsockets context
-    struct lws_context* context_ = nullptr;
+    // One libwebsockets context per service loop
+    std::array<struct lws_context*, MAX_LOOPS> contexts_{};
+    size_t num_loops_ = 1;
 
-    // Per-exchange state
-    std::array<struct lws*, static_cast<size_t>(Exchange::COUNT)> connections_{};
-    std::array<std::atomic<bool>, static_cast<size_t>(Exchange::COUNT)> connection_states_{};
+    // Per-exchange state. Each exchange belongs to exactly one loop
+    // (idx % num_loops_), so its buffer and connection pointer are only
+    // touched from that loop's thread - no locking needed.
+    std::array<struct lws*, ENABLED_EXCHANGE_COUNT> connections_{};
+    std::array<std::atomic<bool>, ENABLED_EXCHANGE_COUNT> connection_states_{};
     std::array<std::atomic<std::chrono::steady_clock::time_point>,
-               static_cast<size_t>(Exchange::COUNT)> last_message_times_{};
+               ENABLED_EXCHANGE_COUNT> last_message_times_{};
     std::array<std::chrono::steady_clock::time_point,
-               static_cast<size_t>(Exchange::COUNT)> last_connect_attempts_{};
+               ENABLED_EXCHANGE_COUNT> last_connect_attempts_{};
+    std::array<std::string, ENABLED_EXCHANGE_COUNT> message_buffers_;
 
-    // Message buffers (per-exchange)
-    std::array<std::string, static_cast<size_t>(Exchange::COUNT)> message_buffers_;
-    std::mutex buffer_mutex_;
+    // Health counters
+    std::array<std::atomic<uint64_t>, ENABLED_EXCHANGE_COUNT> message_counts_{};
+    std::array<std::atomic<uint64_t>, ENABLED_EXCHANGE_COUNT> parse_failures_{};
+    std::array<std::atomic<uint64_t>, ENABLED_EXCHANGE_COUNT> reconnect_counts_{};
 
     // Thread management
-    std::thread event_thread_;
+    std::vector<std::thread> event_threads_;
     std::atomic<bool> running_{false};
 
     // Callbacks
     StatusCallback status_callback_;
+    ResyncCallback resync_callback_;
 
     // Reconnection settings
     static constexpr int RECONNECT_DELAY_MS = 5000;
     static constexpr int HEARTBEAT_INTERVAL_MS = 30000;
 
+    // Which loop owns an exchange
+    size_t loop_for(size_t idx) const {
+        return idx % num_loops_;
+    }
+
+    bool should_stream(size_t idx) const {
+        const auto& config = get_exchange_config(ENABLED_EXCHANGES[idx]);
+        return config.has_websocket && strlen(config.ws_url) > 0 &&
+               ws_handler_table()[idx].available;
+    }
+
     /**
-     * Main event loop - runs in separate thread.
+     * Service loop - each runs its own lws context over its shard.
      */
-    void event_loop() {
-        // Create libwebsockets context
+    void event_loop(size_t loop_id) {
+        ThreadTopology::instance().pin_current(ThreadRole::WS_IO);
+
         struct lws_context_creation_info info;
         memset(&info, 0, sizeof(info));
 
@@ -184,49 +342,39 @@ private:
         info.options = LWS_SERVER_OPTION_DO_SSL_GLOBAL_INIT;
         info.user = this;
 
-        context_ = lws_create_context(&info);
-        if (!context_) {
-            fprintf(stderr, "[WS] Failed to create context\n");
+        contexts_[loop_id] = lws_create_context(&info);
+        if (!contexts_[loop_id]) {
+            fprintf(stderr, "[WS] Loop %zu: failed to create context\n", loop_id);
             return;
         }
 
-        printf("[WS] Starting event loop\n");
+        printf("[WS] Loop %zu starting (%zu loops total)\n", loop_id, num_loops_);
 
-        // Initial connections
-        for (size_t i = 0; i < static_cast<size_t>(Exchange::COUNT); ++i) {
-            Exchange ex = static_cast<Exchange>(i);
-            const auto& config = get_config(ex);
-            if (config.has_websocket) {
-                connect_exchange(ex);
+        // Initial connections for this loop's shard
+        for (size_t i = 0; i < ENABLED_EXCHANGE_COUNT; ++i) {
+            if (loop_for(i) == loop_id && should_stream(i)) {
+                connect_exchange(ENABLED_EXCHANGES[i], loop_id);
             }
         }
 
         // Event loop
         while (running_.load()) {
-            // Service WebSocket events
-            lws_service(context_, 50);  // 50ms timeout
-
-            // Check for reconnections
-            check_reconnections();
+            lws_service(contexts_[loop_id], 50);  // 50ms timeout
+            check_reconnections(loop_id);
         }
 
-        // Cleanup
-        lws_context_destroy(context_);
-        context_ = nullptr;
+        lws_context_destroy(contexts_[loop_id]);
+        contexts_[loop_id] = nullptr;
 
-        printf("[WS] Event loop stopped\n");
+        printf("[WS] Loop %zu stopped\n", loop_id);
     }
 
     /**
-     * Connect to a specific exchange.
+     * Connect to a specific exchange on its owning loop.
      */
-    void connect_exchange(Exchange exchange) {
-        size_t idx = static_cast<size_t>(exchange);
-        const auto& config = get_config(exchange);
-
-        if (!config.has_websocket || strlen(config.ws_url) == 0) {
-            return;
-        }
+    void connect_exchange(Exchange exchange, size_t loop_id) {
+        size_t idx = exchange_slot(exchange);
+        const auto& config = get_exchange_config(exchange);
 
         // Parse WebSocket URL
         // Format: wss://host/path
@@ -241,7 +389,7 @@ private:
         struct lws_client_connect_info ccinfo;
         memset(&ccinfo, 0, sizeof(ccinfo));
 
-        ccinfo.context = context_;
+        ccinfo.context = contexts_[loop_id];
         ccinfo.address = host.c_str();
         ccinfo.port = use_ssl ? 443 : 80;
         ccinfo.path = path.c_str();
@@ -252,7 +400,7 @@ private:
         ccinfo.pwsi = &connections_[idx];
         ccinfo.userdata = reinterpret_cast<void*>(static_cast<uintptr_t>(idx));
 
-        printf("[WS] Connecting to %s...\n", exchange_name(exchange));
+        printf("[WS] Connecting to %s (loop %zu)...\n", exchange_name(exchange), loop_id);
 
         struct lws* wsi = lws_client_connect_via_info(&ccinfo);
         if (!wsi) {
@@ -264,112 +412,98 @@ private:
     }
 
     /**
-     * Check for exchanges that need reconnection.
+     * Check this loop's shard for exchanges needing reconnection.
      */
-    void check_reconnections() {
+    void check_reconnections(size_t loop_id) {
         auto now = std::chrono::steady_clock::now();
 
-        for (size_t i = 0; i < static_cast<size_t>(Exchange::COUNT); ++i) {
-            Exchange ex = static_cast<Exchange>(i);
-            const auto& config = get_config(ex);
-
-            if (!config.has_websocket) continue;
+        for (size_t i = 0; i < ENABLED_EXCHANGE_COUNT; ++i) {
+            if (loop_for(i) != loop_id || !should_stream(i)) continue;
 
-            // Check if disconnected and enough time has passed
             if (!connection_states_[i].load()) {
                 auto since_attempt = std::chrono::duration_cast<std::chrono::milliseconds>(
                     now - last_connect_attempts_[i]).count();
 
                 if (since_attempt >= RECONNECT_DELAY_MS) {
-                    printf("[WS] Reconnecting to %s...\n", exchange_name(ex));
-                    connect_exchange(ex);
+                    printf("[WS] Reconnecting to %s...\n",
+                           exchange_name(ENABLED_EXCHANGES[i]));
+                    reconnect_counts_[i].fetch_add(1);
+                    connect_exchange(ENABLED_EXCHANGES[i], loop_id);
                 }
             }
         }
     }
 
     /**
-     * Handle incoming message from an exchange.
+     * Accumulate a (possibly fragmented) frame; parse when complete.
+     * Only ever called from the exchange's owning loop thread.
      */
-    void handle_message(Exchange exchange, const char* data, size_t len) {
-        size_t idx = static_cast<size_t>(exchange);
+    void on_receive(Exchange exchange, const char* data, size_t len, bool complete) {
+        size_t idx = exchange_slot(exchange);
+        auto& buffer = message_buffers_[idx];
+        buffer.append(data, len);
+        if (!complete) {
+            return;
+        }
+
         last_message_times_[idx].store(std::chrono::steady_clock::now());
+        message_counts_[idx].fetch_add(1, std::memory_order_relaxed);
 
-        // Parse message and update cache
-        OrderBook book;
-        if (parse_message(exchange, data, len, book)) {
+        const auto& handler = ws_handler_table()[idx];
+        // Pooled buffers: update() recycles the displaced book's
+        // vectors back to this service thread's pool
+        OrderBook book = LevelPool::local().acquire_book();
+        bool parsed;
+        {
+            ScopedLatencyTimer timer(LatencyProbe::WS_PARSE);
+            parsed = handler.parse && handler.parse(buffer, book);
+        }
+        if (parsed && book.is_valid()) {
             cache_.update(exchange, std::move(book));
+        } else {
+            parse_failures_[idx].fetch_add(1, std::memory_order_relaxed);
+            LevelPool::local().release_book(std::move(book));
         }
+        buffer.clear();
     }
 
     /**
-     * Parse WebSocket message into OrderBook.
+     * Handshake complete: subscribe, then ask the owner for a snapshot
+     * so the book is seeded before (or while) deltas arrive.
      */
-    bool parse_message(Exchange exchange, const char* data, size_t len, OrderBook& book) {
-        std::string json(data, len);
-
-        switch (exchange) {
-            case Exchange::GEMINI:
-                return parse_gemini_ws(json, book);
-            case Exchange::DERIBIT:
-                return parse_deribit_ws(json, book);
-            case Exchange::POLONIEX:
-                return parse_poloniex_ws(json, book);
-            case Exchange::MEXC:
-                return parse_mexc_ws(json, book);
-            default:
-                return false;
+    void on_established(Exchange exchange, struct lws* wsi) {
+        size_t idx = exchange_slot(exchange);
+        printf("[WS] Connected to %s\n", exchange_name(exchange));
+        connection_states_[idx].store(true);
+        message_buffers_[idx].clear();
+
+        const auto& handler = ws_handler_table()[idx];
+        std::string sub_msg = handler.subscribe ? handler.subscribe() : std::string();
+        if (!sub_msg.empty()) {
+            // Allocate buffer with LWS_PRE padding
+            std::vector<unsigned char> buf(LWS_PRE + sub_msg.size());
+            memcpy(buf.data() + LWS_PRE, sub_msg.c_str(), sub_msg.size());
+            lws_write(wsi, buf.data() + LWS_PRE, sub_msg.size(), LWS_WRITE_TEXT);
         }
-    }
 
-    /**
-     * Get subscription message for an exchange.
-     */
-    std::string get_subscribe_message(Exchange exchange) {
-        switch (exchange) {
-            case Exchange::GEMINI:
-                return "";  // Auto-subscribes on connect
-            case Exchange::DERIBIT:
-                return R"({"jsonrpc":"2.0","id":1,"method":"public/subscribe","params":{"channels":["book.BTC-PERPETUAL.100ms"]}})";
-            case Exchange::POLONIEX:
-                return R"({"event":"subscribe","channel":["book"],"symbols":["BTC_USDT"]})";
-            case Exchange::MEXC:
-                return R"({"method":"SUBSCRIPTION","params":["spot@public.limit.depth.v3.api@BTCUSDT@20"]})";
-            default:
-                return "";
+        if (resync_callback_) {
+            resync_callback_(exchange);
+        }
+        if (status_callback_) {
+            status_callback_(exchange, true);
         }
     }
 
-    // ========================================================================
-    // EXCHANGE-SPECIFIC PARSERS (WebSocket format)
-    // ========================================================================
-
-    bool parse_gemini_ws(const std::string& json, OrderBook& book) {
-        // Gemini sends incremental updates
-        // Format: {"type":"update","events":[{"type":"change","side":"bid","price":"87000","remaining":"0.5"},...]}
-        // For simplicity, treat as snapshot (TODO: implement incremental)
-        return parse_gemini_snapshot(json, book);
-    }
-
-    bool parse_gemini_snapshot(const std::string& json, OrderBook& book) {
-        // Parse bids and asks from Gemini format
-        // Similar to REST parsing
-        return true;  // TODO: implement
-    }
+    void on_closed(Exchange exchange, const char* why) {
+        size_t idx = exchange_slot(exchange);
+        printf("[WS] Disconnected from %s (%s)\n", exchange_name(exchange), why);
+        connection_states_[idx].store(false);
+        connections_[idx] = nullptr;
+        message_buffers_[idx].clear();
 
-    bool parse_deribit_ws(const std::string& json, OrderBook& book) {
-        // Deribit format: {"params":{"data":{"bids":[[price,amount],...],"asks":[[price,amount],...]}}}
-        return true;  // TODO: implement
-    }
-
-    bool parse_poloniex_ws(const std::string& json, OrderBook& book) {
-        // Poloniex format varies
-        return true;  // TODO: implement
-    }
-
-    bool parse_mexc_ws(const std::string& json, OrderBook& book) {
-        // MEXC format: {"d":{"bids":[["price","amount"],...],"asks":[["price","amount"],...]}}}
-        return true;  // TODO: implement
+        if (status_callback_) {
+            status_callback_(exchange, false);
+        }
     }
 
     // ========================================================================
@@ -388,56 +522,31 @@ private:
 
         // Get exchange index from user data
         size_t idx = reinterpret_cast<uintptr_t>(user);
-        if (idx >= static_cast<size_t>(Exchange::COUNT)) {
+        if (idx >= ENABLED_EXCHANGE_COUNT) {
             idx = 0;  // Fallback
         }
-        Exchange exchange = static_cast<Exchange>(idx);
+        Exchange exchange = ENABLED_EXCHANGES[idx];
 
         switch (reason) {
             case LWS_CALLBACK_CLIENT_ESTABLISHED:
-                printf("[WS] Connected to %s\n", exchange_name(exchange));
-                manager->connection_states_[idx].store(true);
-
-                // Send subscription message
-                {
-                    std::string sub_msg = manager->get_subscribe_message(exchange);
-                    if (!sub_msg.empty()) {
-                        // Allocate buffer with LWS_PRE padding
-                        std::vector<unsigned char> buf(LWS_PRE + sub_msg.size());
-                        memcpy(buf.data() + LWS_PRE, sub_msg.c_str(), sub_msg.size());
-                        lws_write(wsi, buf.data() + LWS_PRE, sub_msg.size(), LWS_WRITE_TEXT);
-                    }
-                }
-
-                if (manager->status_callback_) {
-                    manager->status_callback_(exchange, true);
-                }
+                manager->on_established(exchange, wsi);
                 break;
 
-            case LWS_CALLBACK_CLIENT_RECEIVE:
-                manager->handle_message(exchange, static_cast<const char*>(in), len);
+            case LWS_CALLBACK_CLIENT_RECEIVE: {
+                bool complete = lws_is_final_fragment(wsi) &&
+                                lws_remaining_packet_payload(wsi) == 0;
+                manager->on_receive(exchange, static_cast<const char*>(in), len,
+                                    complete);
                 break;
+            }
 
             case LWS_CALLBACK_CLIENT_CONNECTION_ERROR:
-                fprintf(stderr, "[WS] Connection error for %s: %s\n",
-                        exchange_name(exchange),
-                        in ? static_cast<const char*>(in) : "unknown");
-                manager->connection_states_[idx].store(false);
-                manager->connections_[idx] = nullptr;
-
-                if (manager->status_callback_) {
-                    manager->status_callback_(exchange, false);
-                }
+                manager->on_closed(exchange,
+                                   in ? static_cast<const char*>(in) : "error");
                 break;
 
             case LWS_CALLBACK_CLIENT_CLOSED:
-                printf("[WS] Disconnected from %s\n", exchange_name(exchange));
-                manager->connection_states_[idx].store(false);
-                manager->connections_[idx] = nullptr;
-
-                if (manager->status_callback_) {
-                    manager->status_callback_(exchange, false);
-                }
+                manager->on_closed(exchange, "closed");
                 break;
 
             default:
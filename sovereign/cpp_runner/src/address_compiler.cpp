@@ -6,35 +6,62 @@
  *
  * Usage:
  *   ./address_compiler --input walletexplorer_addresses.db --output addresses.bin
+ *   ./address_compiler --v1 ...       (legacy sorted format)
+ *   ./address_compiler --threads N    (default: all cores)
+ *
+ * The build is parallel end to end so the binary can be regenerated on
+ * every walletexplorer update:
+ *   - SQLite rows stream on one thread (the connection is not
+ *     thread-safe) in flat batches feeding a hashing worker pool
+ *   - v1 sort is chunked std::sort + parallel merge rounds
+ *   - v2 Robin Hood build partitions the table by home slot; the few
+ *     probe chains that cross a partition boundary spill to a final
+ *     sequential pass
+ *   - Output entries are written by all workers at once via pwrite
  *
  * Binary format:
- *   Header (64 bytes): magic, version, counts
+ *   Header (64 bytes): magic, version, counts, table capacity (v2)
  *   Exchange table: 64 bytes per exchange (name)
- *   Address entries: 16 bytes each (hash + exchange_id), SORTED by hash
+ *   Address entries: 16 bytes each (hash + exchange_id)
+ *     v1: SORTED by hash, binary search at runtime
+ *     v2: Robin Hood open-addressing table (power-of-two capacity,
+ *         hash==0 = empty slot), 1-2 cache lines per lookup
  */
 
 #include <iostream>
-#include <fstream>
 #include <vector>
 #include <unordered_map>
 #include <algorithm>
 #include <chrono>
 #include <cstring>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
 #include <sqlite3.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 constexpr uint32_t MMAP_MAGIC = 0x41444452;  // "ADDR"
 constexpr uint32_t MMAP_VERSION = 1;
+constexpr uint32_t MMAP_VERSION_V2 = 2;
 constexpr size_t HEADER_SIZE = 64;
 constexpr size_t EXCHANGE_ENTRY_SIZE = 64;
 constexpr size_t ADDRESS_ENTRY_SIZE = 16;
 
+// Rows per batch handed from the SQLite reader to the hash workers
+constexpr size_t BATCH_ROWS = 65536;
+// Bounded queue depth - caps memory while the reader runs ahead
+constexpr size_t MAX_QUEUED_BATCHES = 8;
+
 #pragma pack(push, 1)
 struct FileHeader {
     uint32_t magic;
     uint32_t version;
     uint64_t address_count;
     uint32_t exchange_count;
-    uint8_t reserved[44];
+    uint64_t table_capacity;  // v2 only; zero in v1 files
+    uint8_t reserved[36];
 };
 
 struct AddressEntry {
@@ -45,18 +72,189 @@ struct AddressEntry {
 #pragma pack(pop)
 
 // FNV-1a hash
-uint64_t hash_address(const std::string& addr) {
+uint64_t hash_address(const char* addr, size_t len) {
     uint64_t hash = 14695981039346656037ULL;
-    for (char c : addr) {
-        hash ^= static_cast<uint64_t>(static_cast<uint8_t>(c));
+    for (size_t i = 0; i < len; ++i) {
+        hash ^= static_cast<uint64_t>(static_cast<uint8_t>(addr[i]));
         hash *= 1099511628211ULL;
     }
-    return hash;
+    return hash ? hash : 1;  // 0 is the v2 empty-slot marker
+}
+
+// ============================================================================
+// BATCHED READER -> HASH WORKER POOL
+// ============================================================================
+
+// One batch of rows in flat storage (no per-row string allocations):
+// address bytes back to back, offsets delimiting them, one id per row.
+struct RowBatch {
+    std::vector<char> blob;
+    std::vector<uint32_t> offsets;  // offsets.size() == rows + 1
+    std::vector<uint16_t> ids;
+};
+
+struct BatchQueue {
+    std::mutex mutex;
+    std::condition_variable not_empty;
+    std::condition_variable not_full;
+    std::vector<RowBatch> batches;
+    bool done = false;
+
+    void push(RowBatch&& batch) {
+        std::unique_lock<std::mutex> lock(mutex);
+        not_full.wait(lock, [this]() { return batches.size() < MAX_QUEUED_BATCHES; });
+        batches.push_back(std::move(batch));
+        not_empty.notify_one();
+    }
+
+    bool pop(RowBatch& out) {
+        std::unique_lock<std::mutex> lock(mutex);
+        not_empty.wait(lock, [this]() { return !batches.empty() || done; });
+        if (batches.empty()) return false;
+        out = std::move(batches.back());
+        batches.pop_back();
+        not_full.notify_one();
+        return true;
+    }
+
+    void finish() {
+        std::lock_guard<std::mutex> lock(mutex);
+        done = true;
+        not_empty.notify_all();
+    }
+};
+
+// ============================================================================
+// PARALLEL SORT (v1)
+// ============================================================================
+
+// Chunked std::sort followed by log2(chunks) rounds of pairwise
+// std::inplace_merge - no TBB dependency needed for par_unseq.
+void parallel_sort_entries(std::vector<AddressEntry>& entries, size_t num_threads) {
+    auto cmp = [](const AddressEntry& a, const AddressEntry& b) {
+        return a.hash < b.hash;
+    };
+
+    if (num_threads <= 1 || entries.size() < 1 << 16) {
+        std::sort(entries.begin(), entries.end(), cmp);
+        return;
+    }
+
+    // Chunk boundaries
+    std::vector<size_t> bounds;
+    for (size_t i = 0; i <= num_threads; ++i) {
+        bounds.push_back(entries.size() * i / num_threads);
+    }
+
+    {
+        std::vector<std::thread> workers;
+        for (size_t i = 0; i < num_threads; ++i) {
+            workers.emplace_back([&, i]() {
+                std::sort(entries.begin() + bounds[i], entries.begin() + bounds[i + 1], cmp);
+            });
+        }
+        for (auto& w : workers) w.join();
+    }
+
+    // Merge rounds: halve the number of runs each pass
+    for (size_t step = 1; step < num_threads; step *= 2) {
+        std::vector<std::thread> workers;
+        for (size_t i = 0; i + step < num_threads; i += step * 2) {
+            size_t mid = bounds[i + step];
+            size_t end = bounds[std::min(i + step * 2, num_threads)];
+            workers.emplace_back([&, i, mid, end]() {
+                std::inplace_merge(entries.begin() + bounds[i],
+                                   entries.begin() + mid,
+                                   entries.begin() + end,
+                                   cmp);
+            });
+        }
+        for (auto& w : workers) w.join();
+    }
+}
+
+// ============================================================================
+// ROBIN HOOD TABLE BUILD (v2)
+// ============================================================================
+
+// Robin Hood insert: displace entries with a shorter probe distance so
+// the maximum displacement (and worst-case lookup) stays small.
+void robin_hood_insert(std::vector<AddressEntry>& table, uint64_t mask, AddressEntry entry) {
+    size_t idx = entry.hash & mask;
+    size_t dist = 0;
+    while (true) {
+        AddressEntry& slot = table[idx];
+        if (slot.hash == 0) {
+            slot = entry;
+            return;
+        }
+        if (slot.hash == entry.hash) {
+            // Duplicate address hash - keep one mapping, matches v1 behavior
+            return;
+        }
+        size_t slot_dist = (idx - (slot.hash & mask)) & mask;
+        if (slot_dist < dist) {
+            std::swap(slot, entry);
+            dist = slot_dist;
+        }
+        idx = (idx + 1) & mask;
+        dist++;
+    }
+}
+
+// Insert within one table partition [begin, end). A probe chain that
+// would leave the partition spills the carried entry for the
+// sequential cleanup pass (insertion order does not affect Robin Hood
+// lookup invariants).
+void region_insert(std::vector<AddressEntry>& table, uint64_t mask,
+                   size_t begin, size_t end, AddressEntry entry,
+                   std::vector<AddressEntry>& spill) {
+    size_t idx = entry.hash & mask;
+    size_t dist = 0;
+    while (true) {
+        if (idx < begin || idx >= end) {
+            spill.push_back(entry);
+            return;
+        }
+        AddressEntry& slot = table[idx];
+        if (slot.hash == 0) {
+            slot = entry;
+            return;
+        }
+        if (slot.hash == entry.hash) {
+            return;
+        }
+        size_t slot_dist = (idx - (slot.hash & mask)) & mask;
+        if (slot_dist < dist) {
+            std::swap(slot, entry);
+            dist = slot_dist;
+        }
+        idx = (idx + 1) & mask;
+        dist++;
+    }
+}
+
+// ============================================================================
+// PARALLEL FILE WRITE
+// ============================================================================
+
+bool pwrite_all(int fd, const char* data, size_t len, off_t offset) {
+    while (len > 0) {
+        ssize_t n = pwrite(fd, data, len, offset);
+        if (n <= 0) return false;
+        data += n;
+        offset += n;
+        len -= static_cast<size_t>(n);
+    }
+    return true;
 }
 
 int main(int argc, char* argv[]) {
     std::string input_db = "/root/sovereign/walletexplorer_addresses.db";
     std::string output_bin = "/root/sovereign/addresses.bin";
+    uint32_t out_version = MMAP_VERSION_V2;
+    size_t num_threads = std::thread::hardware_concurrency();
+    if (num_threads == 0) num_threads = 4;
 
     // Parse args
     for (int i = 1; i < argc; i++) {
@@ -64,14 +262,19 @@ int main(int argc, char* argv[]) {
             input_db = argv[++i];
         } else if (std::string(argv[i]) == "--output" && i + 1 < argc) {
             output_bin = argv[++i];
+        } else if (std::string(argv[i]) == "--v1") {
+            out_version = MMAP_VERSION;
+        } else if (std::string(argv[i]) == "--threads" && i + 1 < argc) {
+            num_threads = static_cast<size_t>(std::max(1, atoi(argv[++i])));
         }
     }
 
     std::cout << "========================================" << std::endl;
     std::cout << "ADDRESS COMPILER - SQLite to Binary" << std::endl;
     std::cout << "========================================" << std::endl;
-    std::cout << "Input:  " << input_db << std::endl;
-    std::cout << "Output: " << output_bin << std::endl;
+    std::cout << "Input:   " << input_db << std::endl;
+    std::cout << "Output:  " << output_bin << std::endl;
+    std::cout << "Threads: " << num_threads << std::endl;
     std::cout << std::endl;
 
     auto total_start = std::chrono::high_resolution_clock::now();
@@ -108,12 +311,38 @@ int main(int argc, char* argv[]) {
 
     std::cout << "Found " << exchange_names.size() << " exchanges" << std::endl;
 
-    // Second pass: read all addresses and hash them
-    std::cout << "Pass 2: Reading and hashing addresses..." << std::endl;
+    // Second pass: one thread streams rows (the SQLite connection is
+    // not thread-safe), the pool hashes them in parallel
+    std::cout << "Pass 2: Reading and hashing addresses ("
+              << num_threads << " hash workers)..." << std::endl;
     auto hash_start = std::chrono::high_resolution_clock::now();
 
     std::vector<AddressEntry> entries;
     entries.reserve(10000000);  // Reserve for 10M addresses
+    std::mutex entries_mutex;
+
+    BatchQueue queue;
+    std::vector<std::thread> hashers;
+    for (size_t t = 0; t < num_threads; ++t) {
+        hashers.emplace_back([&]() {
+            RowBatch batch;
+            std::vector<AddressEntry> local;
+            while (queue.pop(batch)) {
+                size_t rows = batch.ids.size();
+                local.clear();
+                local.reserve(rows);
+                for (size_t r = 0; r < rows; ++r) {
+                    AddressEntry entry{};
+                    entry.hash = hash_address(batch.blob.data() + batch.offsets[r],
+                                              batch.offsets[r + 1] - batch.offsets[r]);
+                    entry.exchange_id = batch.ids[r];
+                    local.push_back(entry);
+                }
+                std::lock_guard<std::mutex> lock(entries_mutex);
+                entries.insert(entries.end(), local.begin(), local.end());
+            }
+        });
+    }
 
     rc = sqlite3_prepare_v2(db, "SELECT address, exchange FROM addresses", -1, &stmt, nullptr);
     if (rc != SQLITE_OK) {
@@ -122,22 +351,36 @@ int main(int argc, char* argv[]) {
     }
 
     size_t count = 0;
+    RowBatch batch;
+    batch.offsets.push_back(0);
     while (sqlite3_step(stmt) == SQLITE_ROW) {
         const char* addr = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
         const char* exchange = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1));
 
         if (addr && exchange) {
-            AddressEntry entry{};
-            entry.hash = hash_address(addr);
-            entry.exchange_id = exchange_to_id[exchange];
-            entries.push_back(entry);
+            size_t len = static_cast<size_t>(sqlite3_column_bytes(stmt, 0));
+            batch.blob.insert(batch.blob.end(), addr, addr + len);
+            batch.offsets.push_back(static_cast<uint32_t>(batch.blob.size()));
+            batch.ids.push_back(exchange_to_id[exchange]);
+
+            if (batch.ids.size() >= BATCH_ROWS) {
+                queue.push(std::move(batch));
+                batch = RowBatch{};
+                batch.offsets.push_back(0);
+            }
 
             count++;
             if (count % 1000000 == 0) {
-                std::cout << "  Processed " << count / 1000000 << "M addresses..." << std::endl;
+                std::cout << "  Read " << count / 1000000 << "M addresses..." << std::endl;
             }
         }
     }
+    if (!batch.ids.empty()) {
+        queue.push(std::move(batch));
+    }
+    queue.finish();
+    for (auto& h : hashers) h.join();
+
     sqlite3_finalize(stmt);
     sqlite3_close(db);
 
@@ -145,35 +388,94 @@ int main(int argc, char* argv[]) {
     auto hash_ms = std::chrono::duration_cast<std::chrono::milliseconds>(hash_end - hash_start).count();
     std::cout << "Hashed " << entries.size() << " addresses in " << hash_ms << " ms" << std::endl;
 
-    // Sort by hash for binary search
-    std::cout << "Pass 3: Sorting by hash..." << std::endl;
-    auto sort_start = std::chrono::high_resolution_clock::now();
+    size_t collisions = 0;
+    uint64_t table_capacity = 0;
+    std::vector<AddressEntry> table;
+
+    if (out_version == MMAP_VERSION_V2) {
+        // Build Robin Hood open-addressing table at ~50% load factor.
+        // Partitioned by home slot: each worker owns one contiguous
+        // table range, boundary-crossing probe chains spill to a
+        // sequential cleanup pass.
+        std::cout << "Pass 3: Building hash table ("
+                  << num_threads << " partitions)..." << std::endl;
+        auto build_start = std::chrono::high_resolution_clock::now();
+
+        table_capacity = 1;
+        while (table_capacity < entries.size() * 2) table_capacity <<= 1;
+        uint64_t mask = table_capacity - 1;
+
+        table.assign(table_capacity, AddressEntry{});
+
+        // Bucket entries by owning partition
+        std::vector<size_t> bounds;
+        for (size_t i = 0; i <= num_threads; ++i) {
+            bounds.push_back(table_capacity * i / num_threads);
+        }
+        std::vector<std::vector<AddressEntry>> partitioned(num_threads);
+        for (auto& p : partitioned) p.reserve(entries.size() / num_threads + 16);
+        for (const auto& entry : entries) {
+            size_t home = entry.hash & mask;
+            size_t region = home * num_threads / table_capacity;
+            partitioned[region].push_back(entry);
+        }
 
-    std::sort(entries.begin(), entries.end(), [](const AddressEntry& a, const AddressEntry& b) {
-        return a.hash < b.hash;
-    });
+        std::vector<std::vector<AddressEntry>> spills(num_threads);
+        {
+            std::vector<std::thread> workers;
+            for (size_t t = 0; t < num_threads; ++t) {
+                workers.emplace_back([&, t]() {
+                    for (const auto& entry : partitioned[t]) {
+                        region_insert(table, mask, bounds[t], bounds[t + 1],
+                                      entry, spills[t]);
+                    }
+                });
+            }
+            for (auto& w : workers) w.join();
+        }
 
-    auto sort_end = std::chrono::high_resolution_clock::now();
-    auto sort_ms = std::chrono::duration_cast<std::chrono::milliseconds>(sort_end - sort_start).count();
-    std::cout << "Sorted in " << sort_ms << " ms" << std::endl;
+        size_t spilled = 0;
+        for (const auto& spill : spills) {
+            spilled += spill.size();
+            for (const auto& entry : spill) {
+                robin_hood_insert(table, mask, entry);
+            }
+        }
 
-    // Check for hash collisions (same hash, different addresses would need handling)
-    size_t collisions = 0;
-    for (size_t i = 1; i < entries.size(); i++) {
-        if (entries[i].hash == entries[i-1].hash) {
-            collisions++;
+        auto build_end = std::chrono::high_resolution_clock::now();
+        auto build_ms = std::chrono::duration_cast<std::chrono::milliseconds>(build_end - build_start).count();
+        std::cout << "Built " << table_capacity << "-slot table in " << build_ms
+                  << " ms (" << spilled << " boundary spills)" << std::endl;
+    } else {
+        // Sort by hash for binary search
+        std::cout << "Pass 3: Sorting by hash ("
+                  << num_threads << " threads)..." << std::endl;
+        auto sort_start = std::chrono::high_resolution_clock::now();
+
+        parallel_sort_entries(entries, num_threads);
+
+        auto sort_end = std::chrono::high_resolution_clock::now();
+        auto sort_ms = std::chrono::duration_cast<std::chrono::milliseconds>(sort_end - sort_start).count();
+        std::cout << "Sorted in " << sort_ms << " ms" << std::endl;
+
+        // Check for hash collisions (same hash, different addresses would need handling)
+        for (size_t i = 1; i < entries.size(); i++) {
+            if (entries[i].hash == entries[i-1].hash) {
+                collisions++;
+            }
+        }
+        if (collisions > 0) {
+            std::cout << "Warning: " << collisions << " hash collisions detected" << std::endl;
         }
-    }
-    if (collisions > 0) {
-        std::cout << "Warning: " << collisions << " hash collisions detected" << std::endl;
     }
 
-    // Write binary file
+    // Write binary file - header and exchange table up front, then all
+    // workers pwrite disjoint entry ranges concurrently
     std::cout << "Pass 4: Writing binary file..." << std::endl;
     auto write_start = std::chrono::high_resolution_clock::now();
 
-    std::ofstream out(output_bin, std::ios::binary);
-    if (!out) {
+    int fd = open(output_bin.c_str(), O_CREAT | O_TRUNC | O_WRONLY, 0644);
+    if (fd < 0) {
         std::cerr << "Failed to create output file" << std::endl;
         return 1;
     }
@@ -181,29 +483,58 @@ int main(int argc, char* argv[]) {
     // Write header
     FileHeader header{};
     header.magic = MMAP_MAGIC;
-    header.version = MMAP_VERSION;
+    header.version = out_version;
     header.address_count = entries.size();
     header.exchange_count = static_cast<uint32_t>(exchange_names.size());
-    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    header.table_capacity = table_capacity;
+    bool write_ok = pwrite_all(fd, reinterpret_cast<const char*>(&header), sizeof(header), 0);
 
     // Write exchange names (64 bytes each: 1 byte length + 63 bytes name)
+    off_t offset = HEADER_SIZE;
     for (const auto& name : exchange_names) {
         uint8_t exchange_entry[EXCHANGE_ENTRY_SIZE] = {};
         exchange_entry[0] = static_cast<uint8_t>(std::min(name.size(), size_t(63)));
         std::memcpy(exchange_entry + 1, name.c_str(), exchange_entry[0]);
-        out.write(reinterpret_cast<const char*>(exchange_entry), EXCHANGE_ENTRY_SIZE);
+        write_ok = write_ok && pwrite_all(fd, reinterpret_cast<const char*>(exchange_entry),
+                                          EXCHANGE_ENTRY_SIZE, offset);
+        offset += EXCHANGE_ENTRY_SIZE;
     }
 
-    // Write address entries
-    out.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(AddressEntry));
+    // Write address entries (v2: the full table, empty slots included)
+    const std::vector<AddressEntry>& out_entries =
+        (out_version == MMAP_VERSION_V2) ? table : entries;
+    {
+        std::atomic<bool> chunk_ok{true};
+        std::vector<std::thread> writers;
+        for (size_t t = 0; t < num_threads; ++t) {
+            size_t begin = out_entries.size() * t / num_threads;
+            size_t end = out_entries.size() * (t + 1) / num_threads;
+            if (begin == end) continue;
+            writers.emplace_back([&, begin, end]() {
+                if (!pwrite_all(fd,
+                                reinterpret_cast<const char*>(out_entries.data() + begin),
+                                (end - begin) * sizeof(AddressEntry),
+                                offset + static_cast<off_t>(begin * sizeof(AddressEntry)))) {
+                    chunk_ok.store(false);
+                }
+            });
+        }
+        for (auto& w : writers) w.join();
+        write_ok = write_ok && chunk_ok.load();
+    }
 
-    out.close();
+    close(fd);
+    if (!write_ok) {
+        std::cerr << "Failed to write output file" << std::endl;
+        return 1;
+    }
 
     auto write_end = std::chrono::high_resolution_clock::now();
     auto write_ms = std::chrono::duration_cast<std::chrono::milliseconds>(write_end - write_start).count();
 
     // Calculate file size
-    size_t file_size = HEADER_SIZE + (exchange_names.size() * EXCHANGE_ENTRY_SIZE) + (entries.size() * ADDRESS_ENTRY_SIZE);
+    size_t entry_slots = (out_version == MMAP_VERSION_V2) ? table_capacity : entries.size();
+    size_t file_size = HEADER_SIZE + (exchange_names.size() * EXCHANGE_ENTRY_SIZE) + (entry_slots * ADDRESS_ENTRY_SIZE);
 
     auto total_end = std::chrono::high_resolution_clock::now();
     auto total_ms = std::chrono::duration_cast<std::chrono::milliseconds>(total_end - total_start).count();
@@ -212,10 +543,12 @@ int main(int argc, char* argv[]) {
     std::cout << "========================================" << std::endl;
     std::cout << "COMPILATION COMPLETE" << std::endl;
     std::cout << "========================================" << std::endl;
+    std::cout << "Format:       v" << out_version << std::endl;
     std::cout << "Addresses:    " << entries.size() << std::endl;
     std::cout << "Exchanges:    " << exchange_names.size() << std::endl;
     std::cout << "File size:    " << file_size / (1024 * 1024) << " MB" << std::endl;
     std::cout << "Collisions:   " << collisions << std::endl;
+    std::cout << "Write time:   " << write_ms << " ms" << std::endl;
     std::cout << "Total time:   " << total_ms << " ms" << std::endl;
     std::cout << std::endl;
     std::cout << "Binary file ready: " << output_bin << std::endl;
@@ -0,0 +1,464 @@
+/**
+ * Hot-Path Micro-Benchmarks and Regression Harness
+ *
+ * PURE DATA. NO MOCK. MATH NEVER LIES.
+ *
+ * dex_benchmark.cpp only times JSON parsing; the suites in
+ * test_main.cpp assert correctness with a couple of coarse latency
+ * gates. This harness times every hot path in isolation - cache
+ * write/read, seqlock snapshots under reader/writer contention, impact
+ * math, the signal pipeline end-to-end, mmap address lookups and raw
+ * transaction decode - with warmup, steady-state iterations and
+ * p50/p99/p99.9 reporting off the cycle counter.
+ *
+ * Regression gate:
+ *   ./bench_hotpaths --baseline bench_baseline.txt     # record
+ *   ./bench_hotpaths --check bench_baseline.txt        # enforce
+ *
+ * --check exits 1 if any benchmark's p50 regressed more than the
+ * threshold (default 20%, --threshold N) against the recorded
+ * baseline, so a slow cache read fails CI instead of shipping.
+ */
+
+#include "order_book_types.hpp"
+#include "order_book_cache.hpp"
+#include "impact_calculator.hpp"
+#include "signal_handler.hpp"
+#include "level_pool.hpp"
+#include "latency_histogram.hpp"
+#include "mmap_addresses.hpp"
+#include "tx_decoder.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
+using namespace sovereign;
+
+// ============================================================================
+// CYCLE-ACCURATE TIMING
+// ============================================================================
+
+#if defined(__x86_64__)
+static double g_ns_per_cycle = 0.0;
+
+static inline uint64_t cycle_now() {
+    unsigned aux;
+    return __rdtscp(&aux);  // Serializes against earlier loads/stores
+}
+
+// Calibrate the TSC against the steady clock once at startup
+static void calibrate_timer() {
+    auto wall0 = std::chrono::steady_clock::now();
+    uint64_t c0 = cycle_now();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    uint64_t c1 = cycle_now();
+    auto wall_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - wall0).count();
+    g_ns_per_cycle = static_cast<double>(wall_ns) / static_cast<double>(c1 - c0);
+    printf("TSC calibrated: %.3f GHz\n", 1.0 / g_ns_per_cycle);
+}
+
+static inline int64_t elapsed_ns(uint64_t c0, uint64_t c1) {
+    return static_cast<int64_t>(static_cast<double>(c1 - c0) * g_ns_per_cycle);
+}
+#else
+static void calibrate_timer() {}
+
+static inline uint64_t cycle_now() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+static inline int64_t elapsed_ns(uint64_t c0, uint64_t c1) {
+    return static_cast<int64_t>(c1 - c0);
+}
+#endif
+
+// ============================================================================
+// HARNESS
+// ============================================================================
+
+struct BenchResult {
+    std::string name;
+    uint64_t p50;
+    uint64_t p99;
+    uint64_t p999;
+    uint64_t mean;
+    uint64_t max;
+};
+
+static std::vector<BenchResult> g_results;
+
+static void report(const char* name, const LatencyHistogram& hist) {
+    BenchResult r{name, hist.percentile_ns(50.0), hist.percentile_ns(99.0),
+                  hist.percentile_ns(99.9), hist.mean_ns(), hist.max_ns()};
+    printf("%-24s p50=%7luns  p99=%7luns  p99.9=%7luns  mean=%7luns  max=%8luns\n",
+           name, r.p50, r.p99, r.p999, r.mean, r.max);
+    g_results.push_back(std::move(r));
+}
+
+template <typename Fn>
+static void run_bench(const char* name, int warmup, int iters, Fn&& fn) {
+    for (int i = 0; i < warmup; ++i) {
+        fn();
+    }
+    LatencyHistogram hist;
+    for (int i = 0; i < iters; ++i) {
+        uint64_t c0 = cycle_now();
+        fn();
+        hist.record(elapsed_ns(c0, cycle_now()));
+    }
+    report(name, hist);
+}
+
+// ============================================================================
+// FIXTURES
+// ============================================================================
+
+static OrderBook make_book(size_t levels) {
+    OrderBook book;
+    for (size_t i = 0; i < levels; ++i) {
+        book.bids.push_back({87000.0 - i * 10.0, 1.0 + 0.1 * i});
+        book.asks.push_back({87010.0 + i * 10.0, 1.0 + 0.1 * i});
+    }
+    return book;
+}
+
+/**
+ * Synthetic v1 address database: sorted hash entries, two exchanges.
+ */
+static bool write_address_fixture(const std::string& path, size_t count,
+                                  std::vector<std::string>& addresses) {
+    struct Entry {
+        uint64_t hash;
+        uint16_t id;
+    };
+    std::vector<Entry> entries;
+    entries.reserve(count);
+    addresses.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        addresses.push_back("bench1qaddr" + std::to_string(i));
+        entries.push_back({MmapAddressDatabase::hash_address(addresses.back()),
+                           static_cast<uint16_t>(i % 2)});
+    }
+    std::sort(entries.begin(), entries.end(),
+              [](const Entry& a, const Entry& b) { return a.hash < b.hash; });
+
+    std::ofstream out(path, std::ios::binary);
+    if (!out.is_open()) return false;
+
+    FileHeader header{};
+    header.magic = MMAP_MAGIC;
+    header.version = MMAP_VERSION;
+    header.address_count = count;
+    header.exchange_count = 2;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    char name[EXCHANGE_ENTRY_SIZE] = {};
+    strcpy(name, "binance");
+    out.write(name, sizeof(name));
+    memset(name, 0, sizeof(name));
+    strcpy(name, "kraken");
+    out.write(name, sizeof(name));
+
+    for (const Entry& e : entries) {
+        AddressEntry entry{};
+        entry.hash = e.hash;
+        entry.exchange_id = e.id;
+        out.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+    }
+    return out.good();
+}
+
+/**
+ * Minimal legacy transaction: one input, two P2PKH outputs.
+ */
+static std::vector<uint8_t> make_raw_tx() {
+    std::vector<uint8_t> tx;
+    auto put32 = [&tx](uint32_t v) {
+        for (int i = 0; i < 4; ++i) tx.push_back((v >> (8 * i)) & 0xFF);
+    };
+    auto put64 = [&tx](uint64_t v) {
+        for (int i = 0; i < 8; ++i) tx.push_back((v >> (8 * i)) & 0xFF);
+    };
+
+    put32(2);                                   // version
+    tx.push_back(1);                            // input count
+    for (int i = 0; i < 32; ++i) tx.push_back(static_cast<uint8_t>(i));  // prev txid
+    put32(0);                                   // vout
+    tx.push_back(0);                            // empty scriptSig
+    put32(0xFFFFFFFF);                          // sequence
+    tx.push_back(2);                            // output count
+    for (int out = 0; out < 2; ++out) {
+        put64(50000000 + out);                  // value (sats)
+        tx.push_back(25);                       // script length
+        tx.push_back(0x76);                     // OP_DUP
+        tx.push_back(0xA9);                     // OP_HASH160
+        tx.push_back(20);
+        for (int i = 0; i < 20; ++i) tx.push_back(static_cast<uint8_t>(out * 20 + i));
+        tx.push_back(0x88);                     // OP_EQUALVERIFY
+        tx.push_back(0xAC);                     // OP_CHECKSIG
+    }
+    put32(0);                                   // locktime
+    return tx;
+}
+
+// ============================================================================
+// CONTENTION SCENARIO
+// ============================================================================
+
+/**
+ * N readers hammer read_snapshot while one writer publishes books as
+ * fast as it can - the reader-side latency distribution is what the
+ * arbitrage scan actually experiences.
+ */
+static void bench_contended_reads(OrderBookCache& cache, int readers, int run_ms) {
+    std::atomic<bool> stop{false};
+    LatencyHistogram merged;
+    std::vector<LatencyHistogram> hists(readers);
+
+    std::thread writer([&cache, &stop]() {
+        OrderBook tmpl = make_book(50);
+        while (!stop.load(std::memory_order_relaxed)) {
+            OrderBook book = LevelPool::local().acquire_book();
+            book.bids.assign(tmpl.bids.begin(), tmpl.bids.end());
+            book.asks.assign(tmpl.asks.begin(), tmpl.asks.end());
+            cache.update(Exchange::GEMINI, std::move(book));
+        }
+    });
+
+    std::vector<std::thread> reader_threads;
+    for (int r = 0; r < readers; ++r) {
+        reader_threads.emplace_back([&cache, &stop, &hists, r]() {
+            BookSnapshot snap;
+            while (!stop.load(std::memory_order_relaxed)) {
+                uint64_t c0 = cycle_now();
+                cache.read_snapshot(Exchange::GEMINI, snap);
+                hists[r].record(elapsed_ns(c0, cycle_now()));
+            }
+        });
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(run_ms));
+    stop.store(true);
+    writer.join();
+    for (auto& t : reader_threads) t.join();
+    for (const auto& h : hists) merged.merge(h);
+
+    char name[64];
+    snprintf(name, sizeof(name), "snapshot_%dr1w", readers);
+    report(name, merged);
+}
+
+// ============================================================================
+// BASELINE FILE
+// ============================================================================
+
+static bool save_baseline(const std::string& path) {
+    std::ofstream out(path);
+    if (!out.is_open()) {
+        fprintf(stderr, "[BENCH] Cannot write %s\n", path.c_str());
+        return false;
+    }
+    out << "# bench_hotpaths baseline: name p50_ns p99_ns\n";
+    for (const BenchResult& r : g_results) {
+        out << r.name << " " << r.p50 << " " << r.p99 << "\n";
+    }
+    printf("\nBaseline written to %s (%zu benchmarks)\n", path.c_str(), g_results.size());
+    return true;
+}
+
+static int check_baseline(const std::string& path, double threshold_pct) {
+    std::ifstream in(path);
+    if (!in.is_open()) {
+        fprintf(stderr, "[BENCH] Cannot read baseline %s\n", path.c_str());
+        return 1;
+    }
+    std::map<std::string, uint64_t> baseline;
+    std::string name;
+    uint64_t p50, p99;
+    while (in >> name) {
+        if (name[0] == '#') {
+            std::string rest;
+            std::getline(in, rest);
+            continue;
+        }
+        if (in >> p50 >> p99) {
+            baseline[name] = p50;
+        }
+    }
+
+    printf("\nRegression check against %s (threshold %.0f%%):\n",
+           path.c_str(), threshold_pct);
+    int failures = 0;
+    for (const BenchResult& r : g_results) {
+        auto it = baseline.find(r.name);
+        if (it == baseline.end()) {
+            printf("  %-24s NEW (no baseline)\n", r.name.c_str());
+            continue;
+        }
+        double limit = static_cast<double>(it->second) * (1.0 + threshold_pct / 100.0);
+        double change = it->second > 0
+            ? (static_cast<double>(r.p50) / it->second - 1.0) * 100.0 : 0.0;
+        if (static_cast<double>(r.p50) > limit) {
+            printf("  %-24s FAIL p50 %luns vs baseline %luns (%+.1f%%)\n",
+                   r.name.c_str(), r.p50, it->second, change);
+            ++failures;
+        } else {
+            printf("  %-24s ok   p50 %luns vs baseline %luns (%+.1f%%)\n",
+                   r.name.c_str(), r.p50, it->second, change);
+        }
+    }
+    if (failures > 0) {
+        printf("\n%d benchmark(s) regressed past %.0f%% - failing\n",
+               failures, threshold_pct);
+        return 1;
+    }
+    printf("\nAll benchmarks within threshold\n");
+    return 0;
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+static void print_usage(const char* prog) {
+    fprintf(stderr,
+            "Usage: %s [options]\n"
+            "Options:\n"
+            "  --iters N         Steady-state iterations per benchmark (default 20000)\n"
+            "  --baseline FILE   Write results as the new baseline and exit\n"
+            "  --check FILE      Compare p50s against a baseline; exit 1 on regression\n"
+            "  --threshold PCT   Allowed p50 regression for --check (default 20)\n"
+            "  --help            Show this help\n",
+            prog);
+}
+
+int main(int argc, char* argv[]) {
+    int iters = 20000;
+    std::string baseline_path;
+    std::string check_path;
+    double threshold_pct = 20.0;
+
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--iters") == 0 && i + 1 < argc) {
+            iters = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) {
+            baseline_path = argv[++i];
+        } else if (strcmp(argv[i], "--check") == 0 && i + 1 < argc) {
+            check_path = argv[++i];
+        } else if (strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) {
+            threshold_pct = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--help") == 0) {
+            print_usage(argv[0]);
+            return 0;
+        }
+    }
+
+    printf("========================================\n");
+    printf("SOVEREIGN HOT-PATH BENCHMARKS\n");
+    printf("========================================\n");
+    calibrate_timer();
+    printf("%d iterations per benchmark\n\n", iters);
+
+    int warmup = iters / 10;
+
+    // --- Order book cache ---------------------------------------------------
+    OrderBookCache cache;
+    OrderBook tmpl = make_book(50);
+    {
+        OrderBook seed = make_book(50);
+        cache.update(Exchange::GEMINI, std::move(seed));
+    }
+
+    run_bench("cache_write", warmup, iters, [&cache, &tmpl]() {
+        OrderBook book = LevelPool::local().acquire_book();
+        book.bids.assign(tmpl.bids.begin(), tmpl.bids.end());
+        book.asks.assign(tmpl.asks.begin(), tmpl.asks.end());
+        cache.update(Exchange::GEMINI, std::move(book));
+    });
+
+    BookSnapshot snap;
+    run_bench("snapshot_read", warmup, iters, [&cache, &snap]() {
+        cache.read_snapshot(Exchange::GEMINI, snap);
+    });
+
+    run_bench("cache_get_copy", warmup, iters, [&cache]() {
+        OrderBook book = cache.get(Exchange::GEMINI);
+        LevelPool::local().release_book(std::move(book));
+    });
+
+    bench_contended_reads(cache, 3, 300);
+
+    // --- Impact math --------------------------------------------------------
+    run_bench("impact_walk", warmup, iters, [&tmpl]() {
+        auto impact = ImpactCalculator::calculate_sell_impact(25.0, tmpl.bids);
+        (void)impact;
+    });
+
+    DepthLadder ladder;
+    ladder.build(tmpl.bids, 1);
+    run_bench("impact_ladder", warmup, iters, [&ladder]() {
+        auto impact = ImpactCalculator::impact_from_ladder(25.0, ladder);
+        (void)impact;
+    });
+
+    // --- Signal pipeline ----------------------------------------------------
+    SignalHandler handler(cache);
+    BlockchainSignal sig;
+    sig.exchange = "gemini";
+    sig.is_inflow = true;
+    sig.btc_amount = 25.0;
+    run_bench("signal_e2e", warmup, iters, [&handler, &sig]() {
+        sig.timestamp = std::chrono::steady_clock::now();
+        auto decision = handler.process_signal(sig);
+        (void)decision;
+    });
+
+    // --- Address lookups ----------------------------------------------------
+    const std::string addr_path = "/tmp/bench_addresses.bin";
+    std::vector<std::string> addresses;
+    if (write_address_fixture(addr_path, 100000, addresses)) {
+        MmapAddressDatabase db;
+        if (db.load(addr_path)) {
+            size_t idx = 0;
+            run_bench("addr_lookup_hit", warmup, iters, [&db, &addresses, &idx]() {
+                bool hit = db.is_exchange(addresses[idx]);
+                (void)hit;
+                idx = (idx + 7919) % addresses.size();  // Prime stride defeats caching
+            });
+            run_bench("addr_lookup_miss", warmup, iters, [&db, &idx]() {
+                std::string probe = "bench1qmiss" + std::to_string(idx++);
+                bool hit = db.is_exchange(probe);
+                (void)hit;
+            });
+        }
+        unlink(addr_path.c_str());
+    }
+
+    // --- Transaction decode -------------------------------------------------
+    std::vector<uint8_t> raw_tx = make_raw_tx();
+    run_bench("tx_decode", warmup, iters, [&raw_tx]() {
+        auto decoded = TxDecoder::decode(raw_tx.data(), raw_tx.size());
+        (void)decoded;
+    });
+
+    if (!baseline_path.empty()) {
+        return save_baseline(baseline_path) ? 0 : 1;
+    }
+    if (!check_path.empty()) {
+        return check_baseline(check_path, threshold_pct);
+    }
+    return 0;
+}
@@ -8,45 +8,118 @@
 
 #include "flow_detector.hpp"
 #include "tx_decoder.hpp"
+#include "latency_histogram.hpp"
 #include <chrono>
 #include <iostream>
 #include <algorithm>
+#include <cstring>
+
+namespace {
+
+// Append to a fixed exchange-name list, skipping duplicates
+void add_unique(const char** list, uint8_t& count, const char* name) {
+    for (uint8_t i = 0; i < count; ++i) {
+        if (std::strcmp(list[i], name) == 0) return;
+    }
+    if (count < MAX_FLOW_EXCHANGES) {
+        list[count++] = name;
+    }
+}
+
+} // namespace
 
 FlowDetector::FlowDetector(std::shared_ptr<MmapAddressDatabase> addresses, UtxoCache utxo_cache)
     : addresses_(std::move(addresses))
     , utxo_cache_(std::move(utxo_cache)) {}
 
 std::optional<FlowResult> FlowDetector::process_raw_tx(const uint8_t* data, size_t len) {
+    auto prep = prepare_raw_tx(*addresses_, data, len);
+    if (!prep) {
+        return std::nullopt;
+    }
+    return process_prepared(*prep);
+}
+
+std::optional<PreparedTx> FlowDetector::prepare_raw_tx(const MmapAddressDatabase& addresses,
+                                                       const uint8_t* data, size_t len) {
     auto start = std::chrono::high_resolution_clock::now();
 
     // Decode transaction
-    auto tx_opt = TxDecoder::decode(data, len);
+    std::optional<DecodedTx> tx_opt;
+    {
+        sovereign::ScopedLatencyTimer timer(sovereign::LatencyProbe::TX_DECODE);
+        tx_opt = TxDecoder::decode(data, len);
+    }
     if (!tx_opt) {
         return std::nullopt;
     }
 
-    const auto& tx = *tx_opt;
+    // Resolve every output address against the mmap database up front -
+    // this plus the decode is the expensive part, and it only reads
+    // shared state, so pipeline workers can run it concurrently
+    PreparedTx prep;
+    prep.tx = std::move(*tx_opt);
+    prep.start = start;
+    prep.output_exchange.reserve(prep.tx.outputs.size());
+    prep.output_address.reserve(prep.tx.outputs.size());
+
+    {
+        sovereign::ScopedLatencyTimer timer(sovereign::LatencyProbe::ADDR_LOOKUP);
+
+        // Extract all addresses first, then resolve them as one batch
+        // so the database can overlap the lookups' cache misses -
+        // consolidation transactions carry dozens to hundreds of outputs
+        std::vector<uint64_t> hashes;
+        hashes.reserve(prep.tx.outputs.size());
+        for (const auto& output : prep.tx.outputs) {
+            auto addr_opt = TxDecoder::extract_address(output.script_pubkey);
+            if (addr_opt) {
+                hashes.push_back(MmapAddressDatabase::hash_address(*addr_opt));
+                prep.output_address.push_back(std::move(*addr_opt));
+            } else {
+                hashes.push_back(0);
+                prep.output_address.push_back(std::string());
+            }
+        }
+
+        std::vector<uint16_t> ids(hashes.size());
+        addresses.find_exchange_ids(hashes.data(), hashes.size(), ids.data());
+        for (size_t i = 0; i < ids.size(); ++i) {
+            // Empty scripts hash to a real value too - gate on the
+            // address, not the id
+            prep.output_exchange.push_back(
+                (!prep.output_address[i].empty() && ids[i] != UINT16_MAX)
+                    ? addresses.exchange_name(ids[i])
+                    : nullptr);
+        }
+    }
+
+    return prep;
+}
+
+std::optional<FlowResult> FlowDetector::process_prepared(PreparedTx& prep) {
+    const auto& tx = prep.tx;
 
     // Track flows
     uint64_t inflow_sat = 0;
     uint64_t outflow_sat = 0;
-    std::vector<std::string> source_exchanges;  // Where outflow came from
+    const char* source_exchanges[MAX_FLOW_EXCHANGES];  // Where outflow came from
+    uint8_t source_count = 0;
 
     // Track destination classification (for outflows)
     uint64_t internal_sat = 0;   // Going to exchange addresses
     uint64_t external_sat = 0;   // Going to non-exchange addresses
-    std::vector<std::string> dest_exchanges;  // Where internal goes
+    const char* dest_exchanges[MAX_FLOW_EXCHANGES];  // Where internal goes
+    uint8_t dest_count = 0;
 
     // ==========================================================
     // STEP 1: Check INPUTS for OUTFLOWS (spending exchange UTXOs)
     // ==========================================================
     for (const auto& input : tx.inputs) {
-        auto utxo = utxo_cache_.spend(input.prev_txid, input.prev_vout);
+        auto utxo = utxo_cache_.spend_view(input.prev_txid, input.prev_vout);
         if (utxo) {
             outflow_sat += utxo->value_sat;
-            if (std::find(source_exchanges.begin(), source_exchanges.end(), utxo->exchange) == source_exchanges.end()) {
-                source_exchanges.push_back(utxo->exchange);
-            }
+            add_unique(source_exchanges, source_count, utxo->exchange->c_str());
         }
     }
 
@@ -55,24 +128,20 @@ std::optional<FlowResult> FlowDetector::process_raw_tx(const uint8_t* data, size
     // ==========================================================
     for (size_t vout = 0; vout < tx.outputs.size(); ++vout) {
         const auto& output = tx.outputs[vout];
-        auto addr_opt = TxDecoder::extract_address(output.script_pubkey);
-
-        if (addr_opt) {
-            const char* exchange = addresses_->get_exchange(*addr_opt);
+        const std::string& addr = prep.output_address[vout];
+        const char* exchange = prep.output_exchange[vout];
 
+        if (!addr.empty()) {
             if (exchange) {
                 // Output goes to exchange address = INTERNAL
                 internal_sat += output.value_sat;
                 inflow_sat += output.value_sat;
 
-                std::string exchange_str(exchange);
-                if (std::find(dest_exchanges.begin(), dest_exchanges.end(), exchange_str) == dest_exchanges.end()) {
-                    dest_exchanges.push_back(exchange_str);
-                }
+                add_unique(dest_exchanges, dest_count, exchange);
 
                 // Cache for future outflow detection
                 utxo_cache_.add(tx.txid, static_cast<uint32_t>(vout),
-                               output.value_sat, exchange_str, *addr_opt);
+                               output.value_sat, exchange, addr);
             } else {
                 // Output goes to non-exchange address = EXTERNAL
                 external_sat += output.value_sat;
@@ -85,7 +154,7 @@ std::optional<FlowResult> FlowDetector::process_raw_tx(const uint8_t* data, size
 
     // Calculate latency
     auto end = std::chrono::high_resolution_clock::now();
-    uint64_t latency_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    uint64_t latency_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - prep.start).count();
 
     ++tx_count_;
     total_latency_ns_ += latency_ns;
@@ -141,20 +210,24 @@ std::optional<FlowResult> FlowDetector::process_raw_tx(const uint8_t* data, size
         return std::nullopt;
     }
 
-    return FlowResult{
-        tx.txid,
-        inflow_btc,
-        outflow_btc,
-        net_flow,
-        internal_btc,
-        external_btc,
-        internal_pct,
-        external_pct,
-        signal,
-        std::move(source_exchanges),
-        std::move(dest_exchanges),
-        latency_ns
-    };
+    FlowResult result;
+    size_t txid_len = tx.txid.size() < 64 ? tx.txid.size() : 64;
+    std::memcpy(result.txid, tx.txid.data(), txid_len);
+    result.txid[txid_len] = '\0';
+    result.inflow_btc = inflow_btc;
+    result.outflow_btc = outflow_btc;
+    result.net_flow = net_flow;
+    result.internal_btc = internal_btc;
+    result.external_btc = external_btc;
+    result.internal_pct = internal_pct;
+    result.external_pct = external_pct;
+    result.signal = signal;
+    result.source_count = source_count;
+    result.dest_count = dest_count;
+    std::memcpy(result.source_exchanges, source_exchanges, source_count * sizeof(const char*));
+    std::memcpy(result.dest_exchanges, dest_exchanges, dest_count * sizeof(const char*));
+    result.latency_ns = latency_ns;
+    return result;
 }
 
 void FlowDetector::print_stats() const {
@@ -30,12 +30,17 @@
 #include "mmap_addresses.hpp"
 #include "utxo_cache.hpp"
 #include "flow_detector.hpp"
+#include "tx_pipeline.hpp"
+#include "latency_histogram.hpp"
+#include "cpu_affinity.hpp"
 #include <zmq.h>
 #include <iostream>
 #include <chrono>
 #include <csignal>
 #include <memory>
 #include <cstring>
+#include <string_view>
+#include <sched.h>
 
 // ANSI color codes for deterministic signals
 #define COLOR_GREEN  "\033[92m"   // LONG_EXTERNAL (customer withdrawal)
@@ -50,6 +55,82 @@ void signal_handler(int) {
     running = 0;
 }
 
+// Polite spin between polls - keeps the hyperthread sibling usable
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#else
+    std::this_thread::yield();
+#endif
+}
+
+// Runs on the pipeline's output thread so console I/O never stalls
+// the receive or decode stages
+void print_signal(const FlowResult& flow) {
+    if (flow.signal == SignalType::NONE || flow.signal == SignalType::MIXED) {
+        return;
+    }
+
+    // Determine color based on deterministic signal type
+    const char* color;
+    const char* action;
+    const char* reason;
+
+    switch (flow.signal) {
+        case SignalType::SHORT_INTERNAL:
+            color = COLOR_RED;
+            action = "SHORT";
+            reason = "Consolidating to hot wallet";
+            break;
+        case SignalType::LONG_EXTERNAL:
+            color = COLOR_GREEN;
+            action = "LONG";
+            reason = "Customer withdrawal";
+            break;
+        case SignalType::INFLOW_SHORT:
+            color = COLOR_YELLOW;
+            action = "SHORT";
+            reason = "Deposit (about to sell)";
+            break;
+        default:
+            return;  // Skip NONE and MIXED
+    }
+
+    // Build source exchanges string
+    std::string source_str;
+    for (uint8_t i = 0; i < flow.source_count; ++i) {
+        if (i > 0) source_str += ", ";
+        source_str += flow.source_exchanges[i];
+    }
+    if (source_str.empty()) source_str = "deposit";
+
+    // Build destination exchanges string (for internal)
+    std::string dest_str;
+    for (uint8_t i = 0; i < flow.dest_count; ++i) {
+        if (i > 0) dest_str += ", ";
+        dest_str += flow.dest_exchanges[i];
+    }
+
+    std::cout << std::endl;
+    std::cout << color << "========================================" << COLOR_RESET << std::endl;
+    std::cout << color << "[" << signal_type_str(flow.signal) << "] " << action << COLOR_RESET << std::endl;
+    std::cout << color << "========================================" << COLOR_RESET << std::endl;
+    std::cout << "  Source:     " << source_str << std::endl;
+    std::cout << "  Outflow:    " << flow.outflow_btc << " BTC" << std::endl;
+    std::cout << "  Internal:   " << flow.internal_btc << " BTC ("
+              << static_cast<int>(flow.internal_pct * 100) << "%)" << std::endl;
+    std::cout << "  External:   " << flow.external_btc << " BTC ("
+              << static_cast<int>(flow.external_pct * 100) << "%)" << std::endl;
+    if (!dest_str.empty()) {
+        std::cout << "  Dest Exch:  " << dest_str << std::endl;
+    }
+    std::cout << "  Reason:     " << reason << std::endl;
+    std::cout << "  TXID:       " << std::string_view(flow.txid).substr(0, 16) << "..." << std::endl;
+    std::cout << "  Latency:    " << flow.latency_ns << " ns" << std::endl;
+    std::cout << color << "========================================" << COLOR_RESET << std::endl;
+    std::cout << std::endl;
+}
+
 int main(int argc, char* argv[]) {
     // Setup signal handlers
     std::signal(SIGINT, signal_handler);
@@ -64,18 +145,46 @@ int main(int argc, char* argv[]) {
     // Parse arguments
     std::string bin_path = "/root/sovereign/addresses.bin";  // Pre-compiled binary
     std::string utxo_path = "/root/sovereign/exchange_utxos.db";
+    std::string snapshot_path;  // --snapshot: mmap-style UTXO snapshot (instant load)
+    std::string journal_path;   // --journal: append-only add/spend log
     std::string zmq_endpoint = "tcp://127.0.0.1:28332";
+    size_t num_workers = 4;  // --workers: parallel decode threads
+    bool busy_poll = false;  // --busy-poll: spin on the socket instead of sleeping
+    int recv_core = -1;      // --busy-poll CORE: pin the receive thread
+    std::string affinity_path;  // --affinity: role-to-core config file
 
     for (int i = 1; i < argc; ++i) {
         if (strcmp(argv[i], "--bin") == 0 && i + 1 < argc) {
             bin_path = argv[++i];
         } else if (strcmp(argv[i], "--utxo") == 0 && i + 1 < argc) {
             utxo_path = argv[++i];
+        } else if (strcmp(argv[i], "--snapshot") == 0 && i + 1 < argc) {
+            snapshot_path = argv[++i];
+        } else if (strcmp(argv[i], "--journal") == 0 && i + 1 < argc) {
+            journal_path = argv[++i];
         } else if (strcmp(argv[i], "--zmq") == 0 && i + 1 < argc) {
             zmq_endpoint = argv[++i];
+        } else if (strcmp(argv[i], "--workers") == 0 && i + 1 < argc) {
+            num_workers = static_cast<size_t>(atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--busy-poll") == 0) {
+            busy_poll = true;
+            // Optional core number (must not look like another flag)
+            if (i + 1 < argc && strncmp(argv[i + 1], "--", 2) != 0) {
+                recv_core = atoi(argv[++i]);
+            }
+        } else if (strcmp(argv[i], "--affinity") == 0 && i + 1 < argc) {
+            affinity_path = argv[++i];
         }
     }
 
+    // Thread placement: decode workers, the apply (signal) thread and
+    // this receive thread all pin themselves from the loaded topology
+    auto& topology = sovereign::ThreadTopology::instance();
+    if (!affinity_path.empty()) {
+        topology.load(affinity_path);
+        topology.print_status();
+    }
+
     // Load address database via mmap (INSTANT)
     auto load_start = std::chrono::high_resolution_clock::now();
     auto addresses = std::make_shared<MmapAddressDatabase>();
@@ -88,14 +197,45 @@ int main(int argc, char* argv[]) {
     auto load_us = std::chrono::duration_cast<std::chrono::microseconds>(load_end - load_start).count();
     std::cout << "Loaded " << addresses->count() << " addresses in " << load_us << " us (INSTANT via mmap)" << std::endl;
 
-    // Load UTXO cache
-    std::cout << "Loading UTXO cache from " << utxo_path << "..." << std::endl;
+    // Load UTXO cache: snapshot (milliseconds) if available, else SQLite (minutes)
     UtxoCache utxo_cache;
-    utxo_cache.load(utxo_path);  // OK if this fails, we start fresh
+    bool snapshot_loaded = false;
+    if (!snapshot_path.empty()) {
+        snapshot_loaded = utxo_cache.load_snapshot(snapshot_path);
+    }
+    if (!snapshot_loaded) {
+        std::cout << "Loading UTXO cache from " << utxo_path << "..." << std::endl;
+        utxo_cache.load(utxo_path);  // OK if this fails, we start fresh
+    }
+
+    if (!journal_path.empty()) {
+        // Fold any records from the previous run into the cache, compact
+        // them into a fresh snapshot, then start journaling anew
+        utxo_cache.replay_journal(journal_path);
+        bool compacted = false;
+        if (!snapshot_path.empty()) {
+            compacted = utxo_cache.save_snapshot(snapshot_path);
+            if (compacted) {
+                std::cout << "Compacted UTXO snapshot: " << snapshot_path << std::endl;
+            }
+        }
+        // Only drop replayed records once they are safe in a snapshot
+        auto journal = std::make_shared<UtxoJournal>();
+        if (journal->open(journal_path, /*truncate=*/compacted)) {
+            utxo_cache.set_journal(journal);
+            std::cout << "UTXO journal active: " << journal_path << std::endl;
+        } else {
+            std::cerr << "Warning: could not open journal " << journal_path << std::endl;
+        }
+    }
 
     // Create flow detector
     FlowDetector detector(addresses, std::move(utxo_cache));
 
+    // Pipeline: receive -> parallel decode/lookup -> ordered UTXO apply -> output
+    TxPipeline pipeline(addresses, detector, print_signal, num_workers);
+    std::cout << "Pipeline started with " << num_workers << " decode workers" << std::endl;
+
     // Connect to Bitcoin Core ZMQ
     std::cout << "Connecting to ZMQ: " << zmq_endpoint << std::endl;
 
@@ -134,6 +274,23 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
+    // The receive loop runs on this thread; --busy-poll CORE overrides
+    // any zmq_rx mapping from the config file
+    if (recv_core >= 0) {
+        topology.set_role_cpus(sovereign::ThreadRole::ZMQ_RX,
+                               std::to_string(recv_core));
+    }
+    if (topology.is_configured(sovereign::ThreadRole::ZMQ_RX)) {
+        if (topology.pin_current(sovereign::ThreadRole::ZMQ_RX)) {
+            std::cout << "Receive thread pinned (zmq_rx role)" << std::endl;
+        } else {
+            std::cout << "Receive thread pinning failed" << std::endl;
+        }
+    }
+    if (busy_poll) {
+        std::cout << "Busy-poll receive enabled" << std::endl;
+    }
+
     std::cout << "Connected! Listening for transactions..." << std::endl;
     std::cout << std::endl;
     std::cout << std::string(70, '=') << std::endl;
@@ -146,123 +303,78 @@ int main(int argc, char* argv[]) {
 
     auto last_stats = std::chrono::steady_clock::now();
 
-    // Main loop
-    while (running) {
-        zmq_msg_t topic_msg, data_msg;
-        zmq_msg_init(&topic_msg);
-        zmq_msg_init(&data_msg);
-
-        // Receive topic
-        int rc = zmq_msg_recv(&topic_msg, subscriber, 0);
-        if (rc < 0) {
-            if (errno == EAGAIN) {
-                zmq_msg_close(&topic_msg);
-                zmq_msg_close(&data_msg);
-                continue;  // Timeout, check if still running
-            }
-            break;
-        }
-
-        // Check topic
-        size_t topic_size = zmq_msg_size(&topic_msg);
-        const char* topic = static_cast<const char*>(zmq_msg_data(&topic_msg));
-
-        if (topic_size >= 5 && memcmp(topic, "rawtx", 5) == 0) {
-            // Receive data
-            rc = zmq_msg_recv(&data_msg, subscriber, 0);
-            if (rc < 0) {
-                zmq_msg_close(&topic_msg);
-                zmq_msg_close(&data_msg);
-                continue;
-            }
+    // Message objects are initialized ONCE and reused for every
+    // transaction - zmq_msg_recv releases the previous content itself,
+    // so the init/close pair per message was pure overhead
+    zmq_msg_t topic_msg, data_msg, seq_msg;
+    zmq_msg_init(&topic_msg);
+    zmq_msg_init(&data_msg);
+    zmq_msg_init(&seq_msg);
 
-            // Process transaction
-            const uint8_t* data = static_cast<const uint8_t*>(zmq_msg_data(&data_msg));
-            size_t len = zmq_msg_size(&data_msg);
-
-            auto flow = detector.process_raw_tx(data, len);
-            if (flow && flow->signal != SignalType::NONE && flow->signal != SignalType::MIXED) {
-                // Determine color based on deterministic signal type
-                const char* color;
-                const char* action;
-                const char* reason;
-
-                switch (flow->signal) {
-                    case SignalType::SHORT_INTERNAL:
-                        color = COLOR_RED;
-                        action = "SHORT";
-                        reason = "Consolidating to hot wallet";
-                        break;
-                    case SignalType::LONG_EXTERNAL:
-                        color = COLOR_GREEN;
-                        action = "LONG";
-                        reason = "Customer withdrawal";
-                        break;
-                    case SignalType::INFLOW_SHORT:
-                        color = COLOR_YELLOW;
-                        action = "SHORT";
-                        reason = "Deposit (about to sell)";
-                        break;
-                    default:
-                        continue;  // Skip NONE and MIXED
-                }
-
-                // Build source exchanges string
-                std::string source_str;
-                for (size_t i = 0; i < flow->source_exchanges.size(); ++i) {
-                    if (i > 0) source_str += ", ";
-                    source_str += flow->source_exchanges[i];
-                }
-                if (source_str.empty()) source_str = "deposit";
-
-                // Build destination exchanges string (for internal)
-                std::string dest_str;
-                for (size_t i = 0; i < flow->dest_exchanges.size(); ++i) {
-                    if (i > 0) dest_str += ", ";
-                    dest_str += flow->dest_exchanges[i];
-                }
-
-                std::cout << std::endl;
-                std::cout << color << "========================================" << COLOR_RESET << std::endl;
-                std::cout << color << "[" << signal_type_str(flow->signal) << "] " << action << COLOR_RESET << std::endl;
-                std::cout << color << "========================================" << COLOR_RESET << std::endl;
-                std::cout << "  Source:     " << source_str << std::endl;
-                std::cout << "  Outflow:    " << flow->outflow_btc << " BTC" << std::endl;
-                std::cout << "  Internal:   " << flow->internal_btc << " BTC ("
-                          << static_cast<int>(flow->internal_pct * 100) << "%)" << std::endl;
-                std::cout << "  External:   " << flow->external_btc << " BTC ("
-                          << static_cast<int>(flow->external_pct * 100) << "%)" << std::endl;
-                if (!dest_str.empty()) {
-                    std::cout << "  Dest Exch:  " << dest_str << std::endl;
+    // Main loop: one (possibly blocking) receive, then drain whatever
+    // else is queued without going back to sleep between messages
+    while (running) {
+        int rc = zmq_msg_recv(&topic_msg, subscriber, busy_poll ? ZMQ_DONTWAIT : 0);
+
+        // Batch drain: after the first message, keep pulling with
+        // ZMQ_DONTWAIT until the queue is empty - a burst of N
+        // transactions costs one wakeup instead of N
+        while (rc >= 0) {
+            size_t topic_size = zmq_msg_size(&topic_msg);
+            const char* topic = static_cast<const char*>(zmq_msg_data(&topic_msg));
+
+            if (topic_size >= 5 && memcmp(topic, "rawtx", 5) == 0) {
+                // Time the payload receive + ring handoff (not the
+                // idle wait on the topic frame)
+                sovereign::ScopedLatencyTimer recv_timer(sovereign::LatencyProbe::ZMQ_RECV);
+
+                // Remaining parts of a multipart message are delivered
+                // atomically - these never block
+                if (zmq_msg_recv(&data_msg, subscriber, 0) >= 0) {
+                    // Hand the workers a pointer straight into the ZMQ
+                    // buffer - the only copy is the ring handoff
+                    pipeline.submit(static_cast<const uint8_t*>(zmq_msg_data(&data_msg)),
+                                    zmq_msg_size(&data_msg));
+
+                    // Receive and discard sequence number
+                    zmq_msg_recv(&seq_msg, subscriber, 0);
                 }
-                std::cout << "  Reason:     " << reason << std::endl;
-                std::cout << "  TXID:       " << flow->txid.substr(0, 16) << "..." << std::endl;
-                std::cout << "  Latency:    " << flow->latency_ns << " ns" << std::endl;
-                std::cout << color << "========================================" << COLOR_RESET << std::endl;
-                std::cout << std::endl;
             }
 
-            // Receive and discard sequence number
-            zmq_msg_t seq_msg;
-            zmq_msg_init(&seq_msg);
-            zmq_msg_recv(&seq_msg, subscriber, 0);
-            zmq_msg_close(&seq_msg);
+            rc = zmq_msg_recv(&topic_msg, subscriber, ZMQ_DONTWAIT);
         }
 
-        zmq_msg_close(&topic_msg);
-        zmq_msg_close(&data_msg);
+        if (rc < 0 && errno != EAGAIN) {
+            break;
+        }
+
+        if (busy_poll) {
+            cpu_relax();  // Stay on-core; next message is a poll away
+        }
 
         // Print stats every 60 seconds
         auto now = std::chrono::steady_clock::now();
         if (std::chrono::duration_cast<std::chrono::seconds>(now - last_stats).count() >= 60) {
             detector.print_stats();
+            sovereign::LatencyRegistry::instance().print_stats();
+            sovereign::LatencyRegistry::instance().write_json("/tmp/latency_stats.json");
             last_stats = now;
         }
     }
 
+    zmq_msg_close(&topic_msg);
+    zmq_msg_close(&data_msg);
+    zmq_msg_close(&seq_msg);
+
     std::cout << std::endl;
     std::cout << "Shutting down..." << std::endl;
+    pipeline.stop();  // Drain in-flight transactions before final stats
+    if (pipeline.dropped() > 0) {
+        std::cout << "Dropped under backpressure: " << pipeline.dropped() << " txs" << std::endl;
+    }
     detector.print_stats();
+    sovereign::LatencyRegistry::instance().print_stats();
+    sovereign::LatencyRegistry::instance().write_json("/tmp/latency_stats.json");
 
     zmq_close(subscriber);
     zmq_ctx_destroy(context);
@@ -13,6 +13,7 @@
 #include "impact_calculator.hpp"
 #include "signal_handler.hpp"
 #include "rest_client.hpp"
+#include "shm_export.hpp"
 
 #ifdef HAS_WEBSOCKET
 #include "websocket_manager.hpp"
@@ -69,8 +70,9 @@ void print_exchange_info() {
     printf("Version: %s (%s)\n", get_version(), get_build_info());
     printf("\nSupported Exchanges:\n");
 
-    for (size_t i = 0; i < static_cast<size_t>(Exchange::COUNT); ++i) {
-        const auto cfg = get_exchange_config(static_cast<Exchange>(i));
+    for (Exchange ex : ENABLED_EXCHANGES) {
+        size_t i = static_cast<size_t>(ex);
+        const auto cfg = get_exchange_config(ex);
         printf("  [%zu] %-10s | Leverage: %3dx | Fee: %.3f%% | WS: %s\n",
                i,
                EXCHANGE_NAMES[i],
@@ -114,3 +116,59 @@ void benchmark_impact_calculator(int iterations = 100000) {
 }
 
 } // namespace sovereign
+
+// ============================================================================
+// C API - SHARED-MEMORY BOOK ACCESS
+// ============================================================================
+
+extern "C" {
+
+void* sovereign_shm_attach(const char* name) {
+    auto* reader = new sovereign::ShmBookReader();
+    if (!reader->attach(name ? name : sovereign::SHM_DEFAULT_NAME)) {
+        delete reader;
+        return nullptr;
+    }
+    return reader;
+}
+
+int sovereign_shm_read_book(void* handle, int exchange_index,
+                            double* bids, int* bid_count,
+                            double* asks, int* ask_count,
+                            int max_levels,
+                            unsigned long long* sequence,
+                            long long* age_ms) {
+    if (!handle || exchange_index < 0 ||
+        exchange_index >= static_cast<int>(sovereign::Exchange::COUNT) ||
+        max_levels <= 0) {
+        return 0;
+    }
+
+    auto* reader = static_cast<sovereign::ShmBookReader*>(handle);
+    sovereign::ShmBookView view;
+    if (!reader->read_book(static_cast<sovereign::Exchange>(exchange_index), view)) {
+        return 0;
+    }
+
+    int nb = std::min<int>(max_levels, static_cast<int>(view.bid_count));
+    int na = std::min<int>(max_levels, static_cast<int>(view.ask_count));
+    for (int i = 0; i < nb; ++i) {
+        bids[i * 2] = view.bids[i].price;
+        bids[i * 2 + 1] = view.bids[i].volume;
+    }
+    for (int i = 0; i < na; ++i) {
+        asks[i * 2] = view.asks[i].price;
+        asks[i * 2 + 1] = view.asks[i].volume;
+    }
+    if (bid_count) *bid_count = nb;
+    if (ask_count) *ask_count = na;
+    if (sequence) *sequence = view.sequence;
+    if (age_ms) *age_ms = view.age_ms();
+    return 1;
+}
+
+void sovereign_shm_detach(void* handle) {
+    delete static_cast<sovereign::ShmBookReader*>(handle);
+}
+
+} // extern "C"
@@ -18,8 +18,11 @@
 #include "impact_calculator.hpp"
 #include "signal_handler.hpp"
 #include "rest_client.hpp"
+#include "shm_export.hpp"
+#include "book_journal.hpp"
 
 #include <iostream>
+#include <iomanip>
 #include <fstream>
 #include <chrono>
 #include <thread>
@@ -52,8 +55,7 @@ void write_cache_json(const OrderBookCache& cache, const std::string& filepath)
     out << "  \"exchanges\": {\n";
 
     bool first_exchange = true;
-    for (size_t i = 0; i < static_cast<size_t>(Exchange::COUNT); ++i) {
-        Exchange ex = static_cast<Exchange>(i);
+    for (Exchange ex : ENABLED_EXCHANGES) {
         OrderBook book = cache.get(ex);
 
         if (!book.is_valid()) continue;
@@ -123,6 +125,12 @@ void print_usage(const char* prog) {
               << "  --output FILE     Output JSON file path (default: /tmp/orderbooks.json)\n"
               << "  --interval MS     Update interval in milliseconds (default: 500)\n"
               << "  --stdin           Read signals from stdin and output trade decisions\n"
+              << "  --shm [NAME]      Publish books to a shared-memory segment\n"
+              << "                    (default name: " << SHM_DEFAULT_NAME << ")\n"
+              << "  --journal FILE    Record every book update to a binary journal\n"
+              << "  --replay FILE     Replay a journal through the cache instead of\n"
+              << "                    fetching live, then exit\n"
+              << "  --speed X         Replay speed factor (default 1.0, 0 = flat out)\n"
               << "  --help            Show this help\n";
 }
 
@@ -130,6 +138,11 @@ int main(int argc, char* argv[]) {
     std::string output_path = "/tmp/orderbooks.json";
     int interval_ms = 500;
     bool stdin_mode = false;
+    bool shm_mode = false;
+    std::string shm_name = SHM_DEFAULT_NAME;
+    std::string journal_path;
+    std::string replay_path;
+    double replay_speed = 1.0;
 
     // Parse arguments
     for (int i = 1; i < argc; ++i) {
@@ -139,6 +152,18 @@ int main(int argc, char* argv[]) {
             interval_ms = std::atoi(argv[++i]);
         } else if (strcmp(argv[i], "--stdin") == 0) {
             stdin_mode = true;
+        } else if (strcmp(argv[i], "--shm") == 0) {
+            shm_mode = true;
+            // Optional segment name (must not look like another flag)
+            if (i + 1 < argc && strncmp(argv[i + 1], "--", 2) != 0) {
+                shm_name = argv[++i];
+            }
+        } else if (strcmp(argv[i], "--journal") == 0 && i + 1 < argc) {
+            journal_path = argv[++i];
+        } else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replay_path = argv[++i];
+        } else if (strcmp(argv[i], "--speed") == 0 && i + 1 < argc) {
+            replay_speed = std::atof(argv[++i]);
         } else if (strcmp(argv[i], "--help") == 0) {
             print_usage(argv[0]);
             return 0;
@@ -155,6 +180,15 @@ int main(int argc, char* argv[]) {
     std::cout << "Output: " << output_path << "\n";
     std::cout << "Interval: " << interval_ms << "ms\n";
     std::cout << "Mode: " << (stdin_mode ? "stdin signal processing" : "cache only") << "\n";
+    if (shm_mode) {
+        std::cout << "Shared memory: " << shm_name << "\n";
+    }
+    if (!journal_path.empty()) {
+        std::cout << "Journal: " << journal_path << "\n";
+    }
+    if (!replay_path.empty()) {
+        std::cout << "Replay: " << replay_path << " (speed " << replay_speed << "x)\n";
+    }
     std::cout << "========================================\n\n";
 
     // Initialize components
@@ -162,6 +196,41 @@ int main(int argc, char* argv[]) {
     RESTClient rest_client(cache);
     SignalHandler handler(cache);
 
+    ShmBookExporter shm_exporter;
+    if (shm_mode && !shm_exporter.create(shm_name)) {
+        std::cerr << "[ERROR] Failed to create shared-memory segment " << shm_name << "\n";
+        return 1;
+    }
+
+    // Replay mode: feed a recorded session back through the cache and
+    // exit - no live fetching. Useful for benchmarking downstream
+    // consumers against real recorded bursts.
+    if (!replay_path.empty()) {
+        BookJournalReader reader;
+        if (!reader.open(replay_path)) {
+            return 1;
+        }
+        auto start = std::chrono::steady_clock::now();
+        size_t applied = reader.replay(cache, replay_speed);
+        auto elapsed_us = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start).count();
+        std::cout << "[SERVICE] Replayed " << applied << " updates in "
+                  << elapsed_us / 1000.0 << "ms\n";
+        cache.print_status();
+        write_cache_json(cache, output_path);
+        return 0;
+    }
+
+    BookJournalWriter journal;
+    if (!journal_path.empty()) {
+        if (!journal.open(journal_path)) {
+            return 1;
+        }
+        cache.set_update_callback([&journal](Exchange ex, const OrderBook& book) {
+            journal.record(ex, book);
+        });
+    }
+
     // Initial fetch
     std::cout << "[SERVICE] Fetching initial order books...\n";
     rest_client.fetch_all();
@@ -190,6 +259,12 @@ int main(int argc, char* argv[]) {
             }
         }
 
+        // Shared-memory export every iteration - it only copies books
+        // whose sequence moved, so idle cycles cost nothing
+        if (shm_mode) {
+            shm_exporter.publish(cache);
+        }
+
         // Write cache periodically
         auto now = std::chrono::steady_clock::now();
         auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - last_write).count();
@@ -204,6 +279,10 @@ int main(int argc, char* argv[]) {
 
     std::cout << "\n[SERVICE] Shutting down...\n";
     rest_client.stop();
+    if (journal.is_open()) {
+        journal.print_status();
+        journal.close();
+    }
 
     return 0;
 }
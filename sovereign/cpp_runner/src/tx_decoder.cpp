@@ -3,7 +3,19 @@
 #include <array>
 #include <algorithm>
 
-// Simple SHA256 implementation (or use OpenSSL in production)
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#if HAS_OPENSSL
+#include <openssl/evp.h>
+#endif
+
+// Double-SHA256 backends, fastest available picked at runtime:
+// 1. SHA-NI intrinsics when the CPU supports them (~10x the scalar path)
+// 2. OpenSSL EVP when built with HAS_OPENSSL
+// 3. Scalar fallback (always compiled, also the reference for testing)
+// All paths pad on the stack - no per-call heap allocation.
 namespace {
 
 // SHA256 constants
@@ -26,38 +38,22 @@ inline uint32_t sig1(uint32_t x) { return rotr(x, 6) ^ rotr(x, 11) ^ rotr(x, 25)
 inline uint32_t ep0(uint32_t x) { return rotr(x, 7) ^ rotr(x, 18) ^ (x >> 3); }
 inline uint32_t ep1(uint32_t x) { return rotr(x, 17) ^ rotr(x, 19) ^ (x >> 10); }
 
-std::array<uint8_t, 32> sha256(const uint8_t* data, size_t len) {
-    std::array<uint32_t, 8> h = {
-        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
-        0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
-    };
-
-    // Pad message
-    size_t orig_len = len;
-    size_t padded_len = ((len + 8) / 64 + 1) * 64;
-    std::vector<uint8_t> padded(padded_len, 0);
-    memcpy(padded.data(), data, len);
-    padded[len] = 0x80;
-
-    uint64_t bit_len = static_cast<uint64_t>(orig_len) * 8;
-    for (int i = 0; i < 8; ++i) {
-        padded[padded_len - 1 - i] = static_cast<uint8_t>(bit_len >> (i * 8));
-    }
-
-    // Process blocks
-    for (size_t block = 0; block < padded_len; block += 64) {
+// Process num_blocks 64-byte blocks (portable reference implementation)
+void sha256_process_scalar(uint32_t* state, const uint8_t* data, size_t num_blocks) {
+    for (size_t block = 0; block < num_blocks; ++block, data += 64) {
         std::array<uint32_t, 64> w{};
         for (int i = 0; i < 16; ++i) {
-            w[i] = (static_cast<uint32_t>(padded[block + i * 4]) << 24) |
-                   (static_cast<uint32_t>(padded[block + i * 4 + 1]) << 16) |
-                   (static_cast<uint32_t>(padded[block + i * 4 + 2]) << 8) |
-                   (static_cast<uint32_t>(padded[block + i * 4 + 3]));
+            w[i] = (static_cast<uint32_t>(data[i * 4]) << 24) |
+                   (static_cast<uint32_t>(data[i * 4 + 1]) << 16) |
+                   (static_cast<uint32_t>(data[i * 4 + 2]) << 8) |
+                   (static_cast<uint32_t>(data[i * 4 + 3]));
         }
         for (int i = 16; i < 64; ++i) {
             w[i] = ep1(w[i - 2]) + w[i - 7] + ep0(w[i - 15]) + w[i - 16];
         }
 
-        auto [a, b, c, d, e, f, g, hh] = h;
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+        uint32_t e = state[4], f = state[5], g = state[6], hh = state[7];
 
         for (int i = 0; i < 64; ++i) {
             uint32_t t1 = hh + sig1(e) + ch(e, f, g) + K[i] + w[i];
@@ -66,9 +62,161 @@ std::array<uint8_t, 32> sha256(const uint8_t* data, size_t len) {
             d = c; c = b; b = a; a = t1 + t2;
         }
 
-        h[0] += a; h[1] += b; h[2] += c; h[3] += d;
-        h[4] += e; h[5] += f; h[6] += g; h[7] += hh;
+        state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+        state[4] += e; state[5] += f; state[6] += g; state[7] += hh;
+    }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+
+void sha256_process_shani(uint32_t* state, const uint8_t* data, size_t num_blocks);
+
+// CPUID check plus a one-time known-answer test. Some hypervisors and
+// emulators advertise the SHA feature bit but execute the instructions
+// incorrectly; a wrong txid is far worse than a slow one, so verify a
+// single compress against the scalar path before trusting the hardware.
+bool cpu_has_shani() {
+    static const bool has = [] {
+        if (!__builtin_cpu_supports("sha")) return false;
+        static const uint8_t zero_block[64] = {};
+        uint32_t ref[8] = {
+            0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+            0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+        };
+        uint32_t hw[8];
+        memcpy(hw, ref, sizeof(hw));
+        sha256_process_scalar(ref, zero_block, 1);
+        sha256_process_shani(hw, zero_block, 1);
+        return memcmp(ref, hw, sizeof(ref)) == 0;
+    }();
+    return has;
+}
+
+// SHA-NI block processor. Compiled with a target attribute so the TU
+// builds without -msha; only called after cpu_has_shani() says yes.
+// Message schedule: W[i..i+3] = msg2(msg1(Ma, Mb) + alignr(Md, Mc, 4), Md)
+__attribute__((target("sha,sse4.1,ssse3")))
+void sha256_process_shani(uint32_t* state, const uint8_t* data, size_t num_blocks) {
+    const __m128i MASK =
+        _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    // Load and swizzle state into the ABEF/CDGH layout SHA-NI wants
+    __m128i TMP = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[0]));
+    __m128i STATE1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[4]));
+
+    TMP = _mm_shuffle_epi32(TMP, 0xB1);                  // CDAB
+    STATE1 = _mm_shuffle_epi32(STATE1, 0x1B);            // EFGH
+    __m128i STATE0 = _mm_alignr_epi8(TMP, STATE1, 8);    // ABEF
+    STATE1 = _mm_blend_epi16(STATE1, TMP, 0xF0);         // CDGH
+
+#define SHA256_ROUNDS4(M, K_HI, K_LO)                                      \
+    MSG = _mm_add_epi32(M, _mm_set_epi64x(K_HI, K_LO));                    \
+    STATE1 = _mm_sha256rnds2_epu32(STATE1, STATE0, MSG);                   \
+    MSG = _mm_shuffle_epi32(MSG, 0x0E);                                    \
+    STATE0 = _mm_sha256rnds2_epu32(STATE0, STATE1, MSG)
+
+#define SHA256_EXPAND(MA, MB, MC, MD)                                      \
+    MA = _mm_sha256msg2_epu32(                                             \
+        _mm_add_epi32(_mm_sha256msg1_epu32(MA, MB),                        \
+                      _mm_alignr_epi8(MD, MC, 4)),                         \
+        MD)
+
+    while (num_blocks > 0) {
+        __m128i ABEF_SAVE = STATE0;
+        __m128i CDGH_SAVE = STATE1;
+        __m128i MSG;
+
+        __m128i M0 = _mm_shuffle_epi8(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0)), MASK);
+        __m128i M1 = _mm_shuffle_epi8(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16)), MASK);
+        __m128i M2 = _mm_shuffle_epi8(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 32)), MASK);
+        __m128i M3 = _mm_shuffle_epi8(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 48)), MASK);
+
+        // Rounds 0-15 straight from the message
+        SHA256_ROUNDS4(M0, 0xE9B5DBA5B5C0FBCFULL, 0x71374491428A2F98ULL);
+        SHA256_ROUNDS4(M1, 0xAB1C5ED5923F82A4ULL, 0x59F111F13956C25BULL);
+        SHA256_ROUNDS4(M2, 0x550C7DC3243185BEULL, 0x12835B01D807AA98ULL);
+        SHA256_ROUNDS4(M3, 0xC19BF17480DEB1FEULL, 0x9BDC06A772BE5D74ULL);
+
+        // Rounds 16-31
+        SHA256_EXPAND(M0, M1, M2, M3);
+        SHA256_ROUNDS4(M0, 0x240CA1CC0FC19DC6ULL, 0xEFBE4786E49B69C1ULL);
+        SHA256_EXPAND(M1, M2, M3, M0);
+        SHA256_ROUNDS4(M1, 0x76F988DA5CB0A9DCULL, 0x4A7484AA2DE92C6FULL);
+        SHA256_EXPAND(M2, M3, M0, M1);
+        SHA256_ROUNDS4(M2, 0xBF597FC7B00327C8ULL, 0xA831C66D983E5152ULL);
+        SHA256_EXPAND(M3, M0, M1, M2);
+        SHA256_ROUNDS4(M3, 0x1429296706CA6351ULL, 0xD5A79147C6E00BF3ULL);
+
+        // Rounds 32-47
+        SHA256_EXPAND(M0, M1, M2, M3);
+        SHA256_ROUNDS4(M0, 0x53380D134D2C6DFCULL, 0x2E1B213827B70A85ULL);
+        SHA256_EXPAND(M1, M2, M3, M0);
+        SHA256_ROUNDS4(M1, 0x92722C8581C2C92EULL, 0x766A0ABB650A7354ULL);
+        SHA256_EXPAND(M2, M3, M0, M1);
+        SHA256_ROUNDS4(M2, 0xC76C51A3C24B8B70ULL, 0xA81A664BA2BFE8A1ULL);
+        SHA256_EXPAND(M3, M0, M1, M2);
+        SHA256_ROUNDS4(M3, 0x106AA070F40E3585ULL, 0xD6990624D192E819ULL);
+
+        // Rounds 48-63
+        SHA256_EXPAND(M0, M1, M2, M3);
+        SHA256_ROUNDS4(M0, 0x34B0BCB52748774CULL, 0x1E376C0819A4C116ULL);
+        SHA256_EXPAND(M1, M2, M3, M0);
+        SHA256_ROUNDS4(M1, 0x682E6FF35B9CCA4FULL, 0x4ED8AA4A391C0CB3ULL);
+        SHA256_EXPAND(M2, M3, M0, M1);
+        SHA256_ROUNDS4(M2, 0x8CC7020884C87814ULL, 0x78A5636F748F82EEULL);
+        SHA256_EXPAND(M3, M0, M1, M2);
+        SHA256_ROUNDS4(M3, 0xC67178F2BEF9A3F7ULL, 0xA4506CEB90BEFFFAULL);
+
+        STATE0 = _mm_add_epi32(STATE0, ABEF_SAVE);
+        STATE1 = _mm_add_epi32(STATE1, CDGH_SAVE);
+
+        data += 64;
+        --num_blocks;
+    }
+
+#undef SHA256_ROUNDS4
+#undef SHA256_EXPAND
+
+    // Swizzle back to linear A..H and store
+    TMP = _mm_shuffle_epi32(STATE0, 0x1B);       // FEBA
+    STATE1 = _mm_shuffle_epi32(STATE1, 0xB1);    // DCHG
+    STATE0 = _mm_blend_epi16(TMP, STATE1, 0xF0); // DCBA
+    STATE1 = _mm_alignr_epi8(STATE1, TMP, 8);    // HGFE
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[0]), STATE0);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[4]), STATE1);
+}
+
+#endif // __x86_64__ || __i386__
+
+using Sha256ProcessFn = void (*)(uint32_t*, const uint8_t*, size_t);
+
+// Full-message SHA256 with stack-only padding (at most two tail blocks)
+std::array<uint8_t, 32> sha256_oneshot(const uint8_t* data, size_t len,
+                                       Sha256ProcessFn process) {
+    uint32_t h[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+        0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+    };
+
+    size_t full_blocks = len / 64;
+    process(h, data, full_blocks);
+
+    uint8_t tail[128] = {};
+    size_t rem = len - full_blocks * 64;
+    memcpy(tail, data + full_blocks * 64, rem);
+    tail[rem] = 0x80;
+
+    size_t tail_blocks = (rem + 9 > 64) ? 2 : 1;
+    uint64_t bit_len = static_cast<uint64_t>(len) * 8;
+    for (int i = 0; i < 8; ++i) {
+        tail[tail_blocks * 64 - 1 - i] = static_cast<uint8_t>(bit_len >> (i * 8));
     }
+    process(h, tail, tail_blocks);
 
     std::array<uint8_t, 32> result;
     for (int i = 0; i < 8; ++i) {
@@ -80,6 +228,23 @@ std::array<uint8_t, 32> sha256(const uint8_t* data, size_t len) {
     return result;
 }
 
+std::array<uint8_t, 32> sha256(const uint8_t* data, size_t len) {
+#if defined(__x86_64__) || defined(__i386__)
+    if (cpu_has_shani()) {
+        return sha256_oneshot(data, len, sha256_process_shani);
+    }
+#endif
+
+#if HAS_OPENSSL
+    std::array<uint8_t, 32> result;
+    unsigned int out_len = 0;
+    EVP_Digest(data, len, result.data(), &out_len, EVP_sha256(), nullptr);
+    return result;
+#else
+    return sha256_oneshot(data, len, sha256_process_scalar);
+#endif
+}
+
 std::array<uint8_t, 32> double_sha256(const uint8_t* data, size_t len) {
     auto first = sha256(data, len);
     return sha256(first.data(), 32);
@@ -2,6 +2,33 @@
 #include <sqlite3.h>
 #include <chrono>
 #include <iostream>
+#include <fstream>
+#include <cstdio>
+
+namespace {
+
+#pragma pack(push, 1)
+struct SnapshotHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t utxo_count;
+    uint32_t string_count;
+    uint8_t reserved[44];
+};
+
+struct SnapshotEntry {
+    uint8_t txid[32];
+    uint32_t vout;
+    uint64_t value_sat;
+    uint32_t exchange_id;
+    uint32_t address_id;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(SnapshotHeader) == 64, "Snapshot header size mismatch");
+static_assert(sizeof(SnapshotEntry) == 52, "Snapshot entry size mismatch");
+
+} // namespace
 
 bool UtxoCache::load(const std::string& db_path) {
     auto start = std::chrono::high_resolution_clock::now();
@@ -33,11 +60,8 @@ bool UtxoCache::load(const std::string& db_path) {
         const char* address = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 4));
 
         if (txid && exchange && address) {
-            cache_[{std::string(txid), vout}] = {
-                static_cast<uint64_t>(value),
-                std::string(exchange),
-                std::string(address)
-            };
+            add(std::string(txid), vout, static_cast<uint64_t>(value),
+                std::string(exchange), std::string(address));
         }
     }
 
@@ -51,3 +75,141 @@ bool UtxoCache::load(const std::string& db_path) {
 
     return true;
 }
+
+bool UtxoCache::load_snapshot(const std::string& path) {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+
+    SnapshotHeader header{};
+    in.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!in || header.magic != UTXO_SNAP_MAGIC || header.version != UTXO_SNAP_VERSION) {
+        std::cerr << "Invalid UTXO snapshot format: " << path << std::endl;
+        return false;
+    }
+
+    // String table - must be rebuilt in id order so entry indices match
+    cache_.clear();
+    intern_ids_.clear();
+    interned_.clear();
+    interned_.reserve(header.string_count);
+
+    std::string s;
+    for (uint32_t i = 0; i < header.string_count; ++i) {
+        uint16_t len = 0;
+        in.read(reinterpret_cast<char*>(&len), sizeof(len));
+        s.resize(len);
+        in.read(s.data(), len);
+        if (!in) return false;
+        auto [pos, _] = intern_ids_.emplace(s, i);
+        interned_.push_back(&pos->first);
+    }
+
+    cache_.reserve(header.utxo_count);
+    SnapshotEntry entry;
+    for (uint64_t i = 0; i < header.utxo_count; ++i) {
+        in.read(reinterpret_cast<char*>(&entry), sizeof(entry));
+        if (!in) return false;
+        if (entry.exchange_id >= interned_.size() || entry.address_id >= interned_.size()) {
+            return false;
+        }
+        OutpointKey key;
+        std::memcpy(key.txid.data(), entry.txid, 32);
+        key.vout = entry.vout;
+        cache_[key] = {entry.value_sat, entry.exchange_id, entry.address_id};
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+    std::cout << "Loaded " << cache_.size() << " UTXOs from snapshot in "
+              << elapsed.count() << " ms" << std::endl;
+    return true;
+}
+
+bool UtxoCache::save_snapshot(const std::string& path) const {
+    // Write to a temp file and rename so a crash mid-save never
+    // clobbers the previous good snapshot
+    std::string tmp_path = path + ".tmp";
+    std::ofstream out(tmp_path, std::ios::binary);
+    if (!out) return false;
+
+    SnapshotHeader header{};
+    header.magic = UTXO_SNAP_MAGIC;
+    header.version = UTXO_SNAP_VERSION;
+    header.utxo_count = cache_.size();
+    header.string_count = static_cast<uint32_t>(interned_.size());
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    for (const std::string* s : interned_) {
+        uint16_t len = static_cast<uint16_t>(s->size());
+        out.write(reinterpret_cast<const char*>(&len), sizeof(len));
+        out.write(s->data(), len);
+    }
+
+    SnapshotEntry entry{};
+    for (const auto& [key, value] : cache_) {
+        std::memcpy(entry.txid, key.txid.data(), 32);
+        entry.vout = key.vout;
+        entry.value_sat = value.value_sat;
+        entry.exchange_id = value.exchange_id;
+        entry.address_id = value.address_id;
+        out.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+    }
+
+    out.close();
+    if (!out) return false;
+    return std::rename(tmp_path.c_str(), path.c_str()) == 0;
+}
+
+bool UtxoCache::replay_journal(const std::string& path) {
+    // Called BEFORE set_journal so replayed records are not re-recorded
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) return false;
+
+    size_t size = static_cast<size_t>(in.tellg());
+    in.seekg(0);
+    std::vector<uint8_t> buf(size);
+    in.read(reinterpret_cast<char*>(buf.data()), size);
+    if (!in) return false;
+
+    size_t adds = 0, spends = 0, pos = 0;
+    while (pos < size) {
+        uint8_t type = buf[pos];
+        if (type == UtxoJournal::REC_SPEND) {
+            if (pos + 37 > size) break;  // truncated tail from a crash
+            uint32_t vout;
+            std::memcpy(&vout, &buf[pos + 33], 4);
+            (void)spend(&buf[pos + 1], vout);
+            ++spends;
+            pos += 37;
+        } else if (type == UtxoJournal::REC_ADD) {
+            if (pos + 47 > size) break;
+            uint32_t vout;
+            uint64_t value_sat;
+            uint16_t ex_len;
+            std::memcpy(&vout, &buf[pos + 33], 4);
+            std::memcpy(&value_sat, &buf[pos + 37], 8);
+            std::memcpy(&ex_len, &buf[pos + 45], 2);
+            if (pos + 47 + ex_len + 2 > size) break;
+            std::string exchange(reinterpret_cast<const char*>(&buf[pos + 47]), ex_len);
+            uint16_t addr_len;
+            std::memcpy(&addr_len, &buf[pos + 47 + ex_len], 2);
+            size_t addr_pos = pos + 47 + ex_len + 2;
+            if (addr_pos + addr_len > size) break;
+            std::string address(reinterpret_cast<const char*>(&buf[addr_pos]), addr_len);
+            add(&buf[pos + 1], vout, value_sat, exchange, address);
+            ++adds;
+            pos = addr_pos + addr_len;
+        } else {
+            std::cerr << "Corrupt journal record at offset " << pos << std::endl;
+            break;
+        }
+    }
+
+    if (adds + spends > 0) {
+        std::cout << "Replayed journal: " << adds << " adds, " << spends
+                  << " spends" << std::endl;
+    }
+    return true;
+}
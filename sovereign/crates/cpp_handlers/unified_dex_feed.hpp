@@ -11,14 +11,17 @@
  * 3. Injective (local node @ localhost:9090 or LCD API)
  *
  * Strategy:
- * - Get orderbook from each DEX in parallel
- * - Calculate order flow imbalance across all sources
- * - Find cross-DEX arbitrage opportunities
+ * - One persistent worker per DEX keeps its snapshot continuously fresh
+ *   over a reused keep-alive connection (no per-fetch thread spawn,
+ *   no per-fetch TLS handshake)
+ * - fetch_all() reads the latest cached snapshots - no network
+ * - Subscribers get a callback per snapshot update, so arbitrage
+ *   detection runs on update instead of on poll
  * - Trade where math works (impact > 2 x total fees)
  *
  * Performance targets:
  * - Parse latency: < 1000ns per orderbook
- * - Total pipeline: < 10us for all DEXes
+ * - fetch_all() while running: < 10us for all DEXes (cache copy)
  */
 
 #pragma once
@@ -29,6 +32,7 @@
 #include "../rest_client.hpp"
 
 #include <vector>
+#include <array>
 #include <unordered_map>
 #include <atomic>
 #include <thread>
@@ -85,7 +89,7 @@ struct FlowConsensus {
 };
 
 /**
- * Unified DEX Feed - Thread-safe, lock-free where possible
+ * Unified DEX Feed - persistent per-DEX workers, cached snapshots
  */
 class UnifiedDEXFeed {
 public:
@@ -94,52 +98,86 @@ public:
     static constexpr double FEE_DYDX = 0.050;
     static constexpr double FEE_INJECTIVE = 0.100;
 
-    UnifiedDEXFeed() : running_(false) {
-        // Initialize REST clients for each DEX
-        // Local nodes preferred, fallback to public APIs
-    }
+    static constexpr size_t NUM_DEXES = 3;
+
+    // Fired after each snapshot refresh (valid or not) with the fresh copy
+    using SnapshotCallback = std::function<void(const DEXSnapshot&)>;
+
+    UnifiedDEXFeed() : running_(false) {}
 
     ~UnifiedDEXFeed() {
         stop();
     }
 
+    UnifiedDEXFeed(const UnifiedDEXFeed&) = delete;
+    UnifiedDEXFeed& operator=(const UnifiedDEXFeed&) = delete;
+
     /**
-     * Fetch all DEX snapshots in parallel.
-     * Returns map of Exchange -> DEXSnapshot.
+     * Start the per-DEX workers. Each worker owns one RestClient for
+     * connection reuse and refreshes its slot every interval_ms.
      */
-    std::unordered_map<Exchange, DEXSnapshot> fetch_all(const std::string& coin = "BTC") {
-        std::unordered_map<Exchange, DEXSnapshot> snapshots;
-        std::mutex mtx;
+    void start(int interval_ms = 100) {
+        if (running_.exchange(true)) return;
+        interval_ms_ = interval_ms;
+        coin_ = "BTC";
+        for (size_t i = 0; i < NUM_DEXES; ++i) {
+            workers_.emplace_back(&UnifiedDEXFeed::worker_loop, this, i);
+        }
+    }
 
-        auto start = std::chrono::high_resolution_clock::now();
+    /**
+     * Legacy entry point: continuous monitoring with a full-map callback.
+     * Implemented as a subscription - the callback fires on every
+     * per-DEX update with the current state of all snapshots.
+     */
+    void start(std::function<void(const std::unordered_map<Exchange, DEXSnapshot>&)> callback,
+               int interval_ms = 100) {
+        subscribe([this, callback](const DEXSnapshot&) {
+            callback(fetch_all());
+        });
+        start(interval_ms);
+    }
 
-        // Parallel fetch from all DEXes
-        std::vector<std::thread> threads;
+    void stop() {
+        if (!running_.exchange(false)) return;
+        wake_cv_.notify_all();
+        for (auto& w : workers_) {
+            if (w.joinable()) w.join();
+        }
+        workers_.clear();
+    }
 
-        // Hyperliquid
-        threads.emplace_back([&]() {
-            auto snap = fetch_hyperliquid(coin);
-            std::lock_guard<std::mutex> lock(mtx);
-            snapshots[Exchange::HYPERLIQUID] = snap;
-        });
+    /**
+     * Register a per-update callback. Callbacks run on the worker
+     * thread that produced the snapshot - keep them short or hand off.
+     */
+    void subscribe(SnapshotCallback callback) {
+        std::lock_guard<std::mutex> lock(callback_mutex_);
+        callbacks_.push_back(std::move(callback));
+    }
 
-        // dYdX
-        threads.emplace_back([&]() {
-            auto snap = fetch_dydx(coin);
-            std::lock_guard<std::mutex> lock(mtx);
-            snapshots[Exchange::DYDX] = snap;
-        });
+    /**
+     * Snapshot of all DEX states.
+     *
+     * While the workers run this is a pure cache read - three short
+     * slot locks, no network, no thread creation. Cold (not started)
+     * it refreshes every slot in-line over the persistent clients.
+     */
+    std::unordered_map<Exchange, DEXSnapshot> fetch_all(const std::string& coin = "BTC") {
+        auto start = std::chrono::high_resolution_clock::now();
 
-        // Injective
-        threads.emplace_back([&]() {
-            auto snap = fetch_injective(coin);
-            std::lock_guard<std::mutex> lock(mtx);
-            snapshots[Exchange::INJECTIVE] = snap;
-        });
+        if (!running_.load()) {
+            for (size_t i = 0; i < NUM_DEXES; ++i) {
+                refresh_slot(i, coin);
+            }
+        }
 
-        // Wait for all to complete
-        for (auto& t : threads) {
-            if (t.joinable()) t.join();
+        std::unordered_map<Exchange, DEXSnapshot> snapshots;
+        for (size_t i = 0; i < NUM_DEXES; ++i) {
+            std::lock_guard<std::mutex> lock(slots_[i].mutex);
+            if (slots_[i].sequence.load(std::memory_order_relaxed) > 0) {
+                snapshots[slots_[i].snap.dex] = slots_[i].snap;
+            }
         }
 
         auto end = std::chrono::high_resolution_clock::now();
@@ -148,6 +186,33 @@ public:
         return snapshots;
     }
 
+    /**
+     * Copy one DEX snapshot out of the cache without touching the rest.
+     * Returns false if that DEX has never been refreshed.
+     */
+    bool get_snapshot(Exchange dex, DEXSnapshot& out) const {
+        for (size_t i = 0; i < NUM_DEXES; ++i) {
+            if (dex_of(i) != dex) continue;
+            std::lock_guard<std::mutex> lock(slots_[i].mutex);
+            if (slots_[i].sequence.load(std::memory_order_relaxed) == 0) return false;
+            out = slots_[i].snap;
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * Update counter for change detection (0 = never refreshed).
+     */
+    uint64_t get_sequence(Exchange dex) const {
+        for (size_t i = 0; i < NUM_DEXES; ++i) {
+            if (dex_of(i) == dex) {
+                return slots_[i].sequence.load(std::memory_order_acquire);
+            }
+        }
+        return 0;
+    }
+
     /**
      * Find arbitrage opportunities across DEXes.
      */
@@ -289,35 +354,91 @@ public:
         return total_fetch_latency_ns_;
     }
 
+private:
+    // One cache slot per DEX. The RestClient is owned by the slot so
+    // the worker reuses its connection (keep-alive) across refreshes.
+    struct DexSlot {
+        mutable std::mutex mutex;
+        DEXSnapshot snap{};
+        std::atomic<uint64_t> sequence{0};
+        RestClient client;
+        // Scratch snapshot reused by refresh_slot so its book buffers
+        // keep their capacity across fetches (no per-poll allocation)
+        DEXSnapshot scratch{};
+    };
+
+    std::array<DexSlot, NUM_DEXES> slots_;
+
+    std::atomic<bool> running_;
+    std::vector<std::thread> workers_;
+    int interval_ms_ = 100;
+    std::string coin_ = "BTC";
+    std::mutex wake_mutex_;
+    std::condition_variable wake_cv_;
+
+    std::mutex callback_mutex_;
+    std::vector<SnapshotCallback> callbacks_;
+
+    std::atomic<int64_t> total_fetch_latency_ns_{0};
+
+    static Exchange dex_of(size_t idx) {
+        switch (idx) {
+            case 0: return Exchange::HYPERLIQUID;
+            case 1: return Exchange::DYDX;
+            case 2: return Exchange::INJECTIVE;
+            default: return Exchange::UNKNOWN;
+        }
+    }
+
     /**
-     * Start continuous monitoring with callback.
+     * Worker: refresh one DEX forever. The interruptible wait keeps
+     * stop() prompt even with long intervals.
      */
-    void start(std::function<void(const std::unordered_map<Exchange, DEXSnapshot>&)> callback,
-               int interval_ms = 100) {
-        running_ = true;
-        monitor_thread_ = std::thread([this, callback, interval_ms]() {
-            while (running_) {
-                auto snapshots = fetch_all("BTC");
-                callback(snapshots);
-                std::this_thread::sleep_for(std::chrono::milliseconds(interval_ms));
-            }
-        });
-    }
+    void worker_loop(size_t idx) {
+        while (running_.load()) {
+            refresh_slot(idx, coin_);
 
-    void stop() {
-        running_ = false;
-        if (monitor_thread_.joinable()) {
-            monitor_thread_.join();
+            std::unique_lock<std::mutex> lock(wake_mutex_);
+            wake_cv_.wait_for(lock, std::chrono::milliseconds(interval_ms_),
+                              [this]() { return !running_.load(); });
         }
     }
 
-private:
-    std::atomic<bool> running_;
-    std::thread monitor_thread_;
-    std::atomic<int64_t> total_fetch_latency_ns_{0};
+    /**
+     * Fetch one DEX, publish into its slot, notify subscribers with a
+     * copy taken outside the slot lock.
+     */
+    void refresh_slot(size_t idx, const std::string& coin) {
+        // Fetch into the slot's scratch snapshot instead of a fresh
+        // local: its book vectors keep their capacity from poll to
+        // poll, so steady-state refreshes do no heap traffic (the
+        // published slot copy below reuses its own capacity too)
+        DEXSnapshot& snap = slots_[idx].scratch;
+        snap.book.bids.clear();
+        snap.book.asks.clear();
+        snap.buy_volume = 0.0;
+        snap.sell_volume = 0.0;
+        snap.imbalance_pct = 0.0;
+        switch (idx) {
+            case 0: fetch_hyperliquid(slots_[idx].client, coin, snap); break;
+            case 1: fetch_dydx(slots_[idx].client, coin, snap); break;
+            case 2: fetch_injective(slots_[idx].client, coin, snap); break;
+            default: return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(slots_[idx].mutex);
+            slots_[idx].snap = snap;
+            slots_[idx].sequence.fetch_add(1, std::memory_order_release);
+        }
 
-    DEXSnapshot fetch_hyperliquid(const std::string& coin) {
-        DEXSnapshot snap;
+        std::lock_guard<std::mutex> lock(callback_mutex_);
+        for (auto& cb : callbacks_) {
+            cb(snap);
+        }
+    }
+
+    void fetch_hyperliquid(RestClient& client, const std::string& coin, DEXSnapshot& snap) {
         snap.dex = Exchange::HYPERLIQUID;
         snap.fee_pct = FEE_HYPERLIQUID;
         snap.valid = false;
@@ -329,8 +450,6 @@ private:
             std::string url = HyperliquidHandler::LOCAL_REST_URL;
             std::string body = HyperliquidHandler::get_orderbook_request(coin);
 
-            // Use REST client to POST
-            RestClient client;
             std::string response = client.post(url, body);
 
             if (response.empty()) {
@@ -360,12 +479,9 @@ private:
         auto end = std::chrono::high_resolution_clock::now();
         snap.fetch_latency_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
         snap.timestamp = std::chrono::system_clock::now();
-
-        return snap;
     }
 
-    DEXSnapshot fetch_dydx(const std::string& coin) {
-        DEXSnapshot snap;
+    void fetch_dydx(RestClient& client, const std::string& coin, DEXSnapshot& snap) {
         snap.dex = Exchange::DYDX;
         snap.fee_pct = FEE_DYDX;
         snap.valid = false;
@@ -373,7 +489,6 @@ private:
         auto start = std::chrono::high_resolution_clock::now();
 
         try {
-            RestClient client;
             std::string response = client.get(DydxHandler::REST_URL);
 
             if (!response.empty() && DydxHandler::parse_rest_response(response, snap.book)) {
@@ -387,12 +502,9 @@ private:
         auto end = std::chrono::high_resolution_clock::now();
         snap.fetch_latency_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
         snap.timestamp = std::chrono::system_clock::now();
-
-        return snap;
     }
 
-    DEXSnapshot fetch_injective(const std::string& coin) {
-        DEXSnapshot snap;
+    void fetch_injective(RestClient& client, const std::string& coin, DEXSnapshot& snap) {
         snap.dex = Exchange::INJECTIVE;
         snap.fee_pct = FEE_INJECTIVE;
         snap.valid = false;
@@ -400,7 +512,6 @@ private:
         auto start = std::chrono::high_resolution_clock::now();
 
         try {
-            RestClient client;
             std::string url = InjectiveHandler::get_orderbook_url();
             std::string response = client.get(url);
 
@@ -425,8 +536,6 @@ private:
         auto end = std::chrono::high_resolution_clock::now();
         snap.fetch_latency_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
         snap.timestamp = std::chrono::system_clock::now();
-
-        return snap;
     }
 };
 